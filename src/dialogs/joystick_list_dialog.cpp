@@ -20,12 +20,14 @@
 #include "dialogs/joystick_list_dialog.h"
 
 #include <QIcon>
+#include <QDebug>
 #include <QHeaderView>
 #include <sstream>
 
 #include "main.h"
 #include "joystick.h"
 #include "joystick_factory.h"
+#include "joystick_monitor.h"
 #include "joystick_description.h"
 
 JoystickListDialog::JoystickListDialog(QWidget* parent)
@@ -67,6 +69,17 @@ JoystickListDialog::JoystickListDialog(QWidget* parent)
     connect(&m_properties_button, &QPushButton::clicked, this, &JoystickListDialog::onPropertiesButton);
     connect(&m_close_button, &QPushButton::clicked, this, &QDialog::accept);
     
+    connect(&m_prober, &JoystickProber::deviceQueued, this, &JoystickListDialog::onDeviceQueued);
+    connect(&m_prober, &JoystickProber::deviceFound, this, &JoystickListDialog::onDeviceFound);
+    connect(&m_prober, &JoystickProber::deviceFailed, this, &JoystickListDialog::onDeviceFailed);
+    connect(&m_prober, &JoystickProber::deviceTimedOut, this, &JoystickListDialog::onDeviceTimedOut);
+    connect(&m_prober, &JoystickProber::finished, this, &JoystickListDialog::onProbingFinished);
+    
+    // Devices coming and going are applied to the list in place
+    JoystickMonitor* monitor = JoystickMonitor::instance();
+    connect(monitor, &JoystickMonitor::deviceAdded, this, &JoystickListDialog::onHotplugAdded);
+    connect(monitor, &JoystickMonitor::deviceRemoved, this, &JoystickListDialog::onHotplugRemoved);
+    
     m_close_button.setFocus();
     
     onRefreshButton();
@@ -87,62 +100,162 @@ JoystickListDialog::onRowActivated(const QModelIndex& index)
 void
 JoystickListDialog::onRefreshButton()
 {
-    // Get joysticks using the factory, which will use the best backend
-    const std::vector<JoystickDescription>& joysticks = JoystickFactory::getJoysticks();
+    QModelIndex current = treeview.currentIndex();
+    if (current.isValid()) {
+        m_reselect = device_list->item(current.row(), 0)->data(Qt::UserRole).toString();
+    }
     
     device_list->clear();
     device_list->setHorizontalHeaderLabels(QStringList() << "Icon" << "Name");
     
-    for(const auto& joystick : joysticks)
-    {
-        // Create icon item
-        QStandardItem* iconItem = new QStandardItem();
-        QString iconFilename;
-        
-        // Pick appropriate icon based on device name
-        if (joystick.name.find("PLAYSTATION") != std::string::npos ||
-            joystick.name.find("PS3") != std::string::npos ||
-            joystick.name.find("PS4") != std::string::npos ||
-            joystick.name.find("PS5") != std::string::npos) {
-            iconFilename = ":/resources/PS3.png";
-        } else if (joystick.name.find("X-Box") != std::string::npos ||
-                   joystick.name.find("Xbox") != std::string::npos) {
-            iconFilename = ":/resources/xbox360_small.png";
-        } else {
-            iconFilename = ":/resources/generic.png";
-        }
-        
-        iconItem->setIcon(QIcon(iconFilename));
-        iconItem->setData(QString::fromStdString(joystick.filename), Qt::UserRole);
-        
-        // Create text item
-        QStandardItem* textItem = new QStandardItem();
-        
-        std::ostringstream out;
-        out << joystick.name << "\n"
-            << "Device: " << joystick.filename << "\n"
-            << "Axes: " << joystick.axis_count << "\n"
-            << "Buttons: " << joystick.button_count;
-        
-        // Add backend information if using libinput
-        if (joystick.filename.find("/sys/") == 0) {
-            out << "\nBackend: libinput";
+    // Rows show up as the devices answer, see the onDevice*() slots
+    m_prober.start();
+}
+
+int
+JoystickListDialog::findRow(const QString& filename) const
+{
+    for (int row = 0; row < device_list->rowCount(); ++row) {
+        if (device_list->item(row, 0)->data(Qt::UserRole).toString() == filename) {
+            return row;
         }
-        
-        textItem->setText(QString::fromStdString(out.str()));
-        
-        // Add items to model
-        QList<QStandardItem*> row;
-        row << iconItem << textItem;
-        device_list->appendRow(row);
     }
+    return -1;
+}
+
+int
+JoystickListDialog::addRow(const QString& filename)
+{
+    QStandardItem* iconItem = new QStandardItem();
+    iconItem->setIcon(QIcon(":/resources/generic.png"));
+    iconItem->setData(filename, Qt::UserRole);
+    
+    QList<QStandardItem*> row;
+    row << iconItem << new QStandardItem();
+    device_list->appendRow(row);
+    
+    return device_list->rowCount() - 1;
+}
+
+void
+JoystickListDialog::setRowText(int row, const QString& text)
+{
+    device_list->item(row, 1)->setText(text);
+}
+
+void
+JoystickListDialog::onDeviceQueued(const QString& filename)
+{
+    int row = addRow(filename);
+    setRowText(row, filename + "\n" + tr("Probing..."));
+}
+
+void
+JoystickListDialog::onDeviceFound(const JoystickDescription& joystick)
+{
+    QString filename = QString::fromStdString(joystick.filename);
+    int row = findRow(filename);
+    if (row < 0) {
+        row = addRow(filename);
+    }
+    
+    // Pick appropriate icon based on device name
+    QString iconFilename;
+    if (joystick.name.find("PLAYSTATION") != std::string::npos ||
+        joystick.name.find("PS3") != std::string::npos ||
+        joystick.name.find("PS4") != std::string::npos ||
+        joystick.name.find("PS5") != std::string::npos) {
+        iconFilename = ":/resources/PS3.png";
+    } else if (joystick.name.find("X-Box") != std::string::npos ||
+               joystick.name.find("Xbox") != std::string::npos) {
+        iconFilename = ":/resources/xbox360_small.png";
+    } else {
+        iconFilename = ":/resources/generic.png";
+    }
+    device_list->item(row, 0)->setIcon(QIcon(iconFilename));
+    
+    std::ostringstream out;
+    out << joystick.name << "\n"
+        << "Device: " << joystick.filename << "\n"
+        << "Axes: " << joystick.axis_count << "\n"
+        << "Buttons: " << joystick.button_count;
+    
+    // Add backend information if using libinput
+    if (joystick.filename.find("/sys/") == 0) {
+        out << "\nBackend: libinput";
+    } else if (joystick.filename.find("/dev/input/event") == 0) {
+        out << "\nBackend: evdev";
+    }
+    
+    setRowText(row, QString::fromStdString(out.str()));
+    
+    // Select first item if available, or the one that was selected
+    // before it got unplugged
+    if (!treeview.currentIndex().isValid() || filename == m_reselect) {
+        treeview.setCurrentIndex(device_list->index(row, 0));
+    }
+    if (filename == m_reselect) {
+        m_reselect.clear();
+    }
+}
+
+void
+JoystickListDialog::onDeviceFailed(const QString& filename, const QString& error)
+{
+    qDebug() << "Skipping" << filename << ":" << error;
     
-    // Select first item if available
-    if (!joysticks.empty()) {
+    int row = findRow(filename);
+    if (row >= 0) {
+        device_list->removeRow(row);
+    }
+}
+
+void
+JoystickListDialog::onDeviceTimedOut(const QString& filename)
+{
+    int row = findRow(filename);
+    if (row >= 0) {
+        setRowText(row, filename + "\n" + tr("Device is not responding"));
+    }
+}
+
+void
+JoystickListDialog::onProbingFinished()
+{
+    if (!treeview.currentIndex().isValid() && device_list->rowCount() > 0) {
         treeview.setCurrentIndex(device_list->index(0, 0));
     }
 }
 
+void
+JoystickListDialog::onHotplugAdded(const QString& devnode, const QString& syspath)
+{
+    m_prober.probeDevice(devnode, syspath);
+}
+
+void
+JoystickListDialog::onHotplugRemoved(const QString& devnode, const QString& syspath)
+{
+    m_prober.cancel(devnode);
+    m_prober.cancel(syspath);
+    
+    // Rows are keyed by devnode, except for libinput which uses the syspath
+    int row = findRow(devnode);
+    if (row < 0) {
+        row = findRow(syspath);
+    }
+    if (row < 0) {
+        return;
+    }
+    
+    QModelIndex current = treeview.currentIndex();
+    if (current.isValid() && current.row() == row) {
+        m_reselect = device_list->item(row, 0)->data(Qt::UserRole).toString();
+    }
+    
+    device_list->removeRow(row);
+}
+
 void
 JoystickListDialog::onPropertiesButton()
 {
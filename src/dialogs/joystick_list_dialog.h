@@ -28,6 +28,8 @@
 #include <QStandardItemModel>
 #include <QScrollArea>
 
+#include "joystick_prober.h"
+
 class JoystickListDialog : public QDialog
 {
     Q_OBJECT
@@ -44,11 +46,30 @@ private:
 
     QStandardItemModel* device_list;
 
+    JoystickProber m_prober;
+
+    // Filename of the selected device while it is gone, so it gets
+    // selected again when it comes back
+    QString m_reselect;
+
+    int findRow(const QString& filename) const;
+    int addRow(const QString& filename);
+    void setRowText(int row, const QString& text);
+
 private slots:
     void onRefreshButton();
     void onPropertiesButton();
     void onRowActivated(const QModelIndex& index);
 
+    void onDeviceQueued(const QString& filename);
+    void onDeviceFound(const JoystickDescription& joystick);
+    void onDeviceFailed(const QString& filename, const QString& error);
+    void onDeviceTimedOut(const QString& filename);
+    void onProbingFinished();
+
+    void onHotplugAdded(const QString& devnode, const QString& syspath);
+    void onHotplugRemoved(const QString& devnode, const QString& syspath);
+
 public:
     JoystickListDialog(QWidget* parent = nullptr);
 };
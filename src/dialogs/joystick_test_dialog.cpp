@@ -20,12 +20,10 @@
 #include "dialogs/joystick_test_dialog.h"
 
 #include <sstream>
-#include <iostream>
 #include <QIcon>
 
-#include "main.h"
+#include "joystick_gui.h"
 #include "joystick.h"
-#include "widgets/button_widget.h"
 #include "widgets/axis_widget.h"
 #include "widgets/rudder_widget.h"
 #include "widgets/throttle_widget.h"
@@ -35,15 +33,10 @@ JoystickTestDialog::JoystickTestDialog(JoystickGui& gui, Joystick& joystick_, bo
       m_gui(gui),
       joystick(joystick_),
       m_simple_ui(simple_ui),
+      m_presenter(this, joystick_.getAxisCount(), joystick_.getButtonCount()),
       label("<b>" + joystick.getName() + "</b><br>Device: " + QString::fromStdString(joystick.getFilename())),
-      // Initialize widget pointers
-      stick1_widget(new AxisWidget(128, 128)),
-      stick2_widget(new AxisWidget(128, 128)),
-      stick3_widget(new AxisWidget(128, 128)),
-      rudder_widget(new RudderWidget(128, 32)),
-      throttle_widget(new ThrottleWidget(32, 128)),
-      left_trigger_widget(new ThrottleWidget(32, 128, true)),
-      right_trigger_widget(new ThrottleWidget(32, 128, true))
+      axis_bank(joystick_.getAxisCount()),
+      buttons(joystick_.getButtonCount(), 32, 32)
 {
     setWindowTitle(joystick_.getName());
     setWindowIcon(QIcon(":/resources/generic.png"));
@@ -71,44 +64,11 @@ JoystickTestDialog::JoystickTestDialog(JoystickGui& gui, Joystick& joystick_, bo
     
     // Set up axis grid
     axis_grid.setSpacing(5);
-    button_grid.setSpacing(8);
     
-    // Vector to store value labels for each axis
-    axis_value_labels.resize(joystick.getAxisCount());
-    
-    for(int i = 0; i < joystick.getAxisCount(); ++i)
-    {
-        QString labelText = QString("Axis %1: ").arg(i);
-        QLabel* axisLabel = new QLabel(labelText);
-        
-        QProgressBar* progressbar = new QProgressBar();
-        progressbar->setValue(50);
-        
-        // Create a label to show the axis value
-        axis_value_labels[i] = new QLabel("0");
-        axis_value_labels[i]->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        axis_value_labels[i]->setFixedWidth(60);  // Fixed width for consistent display
-        
-        // Each column must have at most 10 axes
-        int x = (i/10)*3;  // *3 instead of *2 to make room for value labels
-        int y = i%10;
-        
-        axis_grid.addWidget(axisLabel, y, x);
-        axis_grid.addWidget(progressbar, y, x+1);
-        axis_grid.addWidget(axis_value_labels[i], y, x+2);
-        
-        axes.push_back(progressbar);
-    }
-    
-    for(int i = 0; i < joystick.getButtonCount(); ++i)
-    {
-        int x = i / 10;
-        int y = i % 10;
-        
-        ButtonWidget* button = new ButtonWidget(32, 32, QString::number(i));
-        button_grid.addWidget(button, y, x);
-        buttons.push_back(button);
-    }
+    // A single widget paints every axis row and another every button,
+    // both ten to a column
+    axis_grid.addWidget(&axis_bank, 0, 0);
+    button_grid.addWidget(&buttons, 0, 0);
     
     // Button box
     buttonbox.addWidget(&mapping_button);
@@ -127,8 +87,6 @@ JoystickTestDialog::JoystickTestDialog(JoystickGui& gui, Joystick& joystick_, bo
     m_vbox.addLayout(&test_hbox);
     m_vbox.addLayout(&buttonbox);
     
-    stick_hbox.setContentsMargins(5, 5, 5, 5);
-    
     axis_callbacks.clear();
     raw_value_callbacks.clear();
     // Initialize callbacks
@@ -137,18 +95,39 @@ JoystickTestDialog::JoystickTestDialog(JoystickGui& gui, Joystick& joystick_, bo
         raw_value_callbacks.push_back([](int){});
     }
     
-    // Check if this is a Thrustmaster HOTAS Warthog or always add stick widget for first two axes
-    bool is_thrustmaster = joystick.getName().contains("Thrustmaster", Qt::CaseInsensitive);
-    bool has_at_least_two_axes = (joystick.getAxisCount() >= 2);
+    // The graphical view only gets built if it is shown at all
+    if (!m_simple_ui)
+    {
+        createStickWidgets();
+        axis_vbox.addLayout(&stick_hbox);
+    }
+    
+    axis_vbox.addLayout(&axis_grid);
+    
+    // Connect signals, one frame carries all changes of a device read and
+    // the presenter merges frames until the display can show them
+    connect(&joystick, &Joystick::frameReady, &m_presenter, &FramePresenter::latch);
+    connect(&m_presenter, &FramePresenter::frameReady, this, &JoystickTestDialog::onFrame);
+    
+    connect(&calibration_button, &QPushButton::clicked, this, &JoystickTestDialog::onCalibrate);
+    connect(&mapping_button, &QPushButton::clicked, this, &JoystickTestDialog::onMapping);
+    connect(&close_button, &QPushButton::clicked, this, &QDialog::accept);
+    
+    close_button.setFocus();
+}
+
+void
+JoystickTestDialog::createStickWidgets()
+{
+    stick_hbox.setContentsMargins(5, 5, 5, 5);
     
     // Always show main stick widget for first two axes if device has at least 2 axes
-    if (has_at_least_two_axes) {
-        stick_hbox.addWidget(stick1_widget, 1, Qt::AlignCenter);
-        raw_value_callbacks[0] = [this](int val) { stick1_widget->setRawX(val); };
-        raw_value_callbacks[1] = [this](int val) { stick1_widget->setRawY(val); };
+    if (joystick.getAxisCount() >= 2) {
+        addStick(0, 1);
     }
     
-    // Continue with the regular joystick type handling
+    // Continue with the regular joystick type handling, only the widgets
+    // a layout uses get created
     switch(joystick.getAxisCount())
     {
     case 2: // Simple stick
@@ -160,119 +139,94 @@ JoystickTestDialog::JoystickTestDialog(JoystickGui& gui, Joystick& joystick_, bo
         QWidget* container = new QWidget();
         QGridLayout* gridLayout = new QGridLayout(container);
         
-        // Don't add stick1_widget again since we already did it above
+        RudderWidget* rudder_widget = new RudderWidget(128, 32);
+        ThrottleWidget* throttle_widget = new ThrottleWidget(32, 128);
         gridLayout->addWidget(rudder_widget, 1, 0);
         gridLayout->addWidget(throttle_widget, 0, 1);
         
         stick_hbox.addWidget(container, 1, Qt::AlignCenter);
-        stick_hbox.addWidget(stick3_widget, 1, Qt::AlignCenter);
+        axis_callbacks[2] = [rudder_widget](double val) { rudder_widget->setPos(val); };
+        axis_callbacks[3] = [throttle_widget](double val) { throttle_widget->setPos(val); };
         
-        // Don't connect stick1_widget again
-        axis_callbacks[2] = [this](double val) { rudder_widget->setPos(val); };
-        axis_callbacks[3] = [this](double val) { throttle_widget->setPos(val); };
-        raw_value_callbacks[4] = [this](int val) { stick3_widget->setRawX(val); };
-        raw_value_callbacks[5] = [this](int val) { stick3_widget->setRawY(val); };
+        addStick(4, 5);
         break;
     }
     
     case 8: // Dual Analog Gamepad + Analog Trigger
-        // Don't add stick1_widget again
-        stick_hbox.addWidget(stick2_widget, 1, Qt::AlignCenter);
-        stick_hbox.addWidget(stick3_widget, 1, Qt::AlignCenter);
-        stick_hbox.addWidget(left_trigger_widget, 1, Qt::AlignCenter);
-        stick_hbox.addWidget(right_trigger_widget, 1, Qt::AlignCenter);
-        
-        // Don't connect stick1_widget again
-        raw_value_callbacks[2] = [this](int val) { stick2_widget->setRawX(val); };
-        raw_value_callbacks[3] = [this](int val) { stick2_widget->setRawY(val); };
-        raw_value_callbacks[6] = [this](int val) { stick3_widget->setRawX(val); };
-        raw_value_callbacks[7] = [this](int val) { stick3_widget->setRawY(val); };
-        axis_callbacks[4] = [this](double val) { left_trigger_widget->setPos(val); };
-        axis_callbacks[5] = [this](double val) { right_trigger_widget->setPos(val); };
+        addStick(2, 3);
+        addStick(6, 7);
+        addTrigger(4);
+        addTrigger(5);
         break;
     
     case 7: // Dual Analog Gamepad DragonRise Inc. Generic USB Joystick
-        // Don't add stick1_widget again
-        stick_hbox.addWidget(stick2_widget, 1, Qt::AlignCenter);
-        stick_hbox.addWidget(stick3_widget, 1, Qt::AlignCenter);
-        
-        // Don't connect stick1_widget again
-        raw_value_callbacks[3] = [this](int val) { stick2_widget->setRawX(val); };
-        raw_value_callbacks[4] = [this](int val) { stick2_widget->setRawY(val); };
-        raw_value_callbacks[5] = [this](int val) { stick3_widget->setRawX(val); };
-        raw_value_callbacks[6] = [this](int val) { stick3_widget->setRawY(val); };
+        addStick(3, 4);
+        addStick(5, 6);
         break;
     
     case 27: // Playstation 3 Controller
-        // Don't add stick1_widget again
-        stick_hbox.addWidget(stick2_widget, 1, Qt::AlignCenter);
+        addStick(2, 3);
         // Not using stick3 for now, as the dpad is 4 axis on the PS3, not 2 (one for each direction)
-        stick_hbox.addWidget(left_trigger_widget, 1, Qt::AlignCenter);
-        stick_hbox.addWidget(right_trigger_widget, 1, Qt::AlignCenter);
-        
-        // Don't connect stick1_widget again
-        raw_value_callbacks[2] = [this](int val) { stick2_widget->setRawX(val); };
-        raw_value_callbacks[3] = [this](int val) { stick2_widget->setRawY(val); };
-        axis_callbacks[12] = [this](double val) { left_trigger_widget->setPos(val); };
-        axis_callbacks[13] = [this](double val) { right_trigger_widget->setPos(val); };
+        addTrigger(12);
+        addTrigger(13);
         break;
     
     default:
-        // Do nothing here, we already added stick1_widget for the first two axes
-        std::cout << "Using default circular display for first two axes" << std::endl;
+        // Do nothing here, the first two axes already got their stick
         break;
     }
+}
+
+void
+JoystickTestDialog::addStick(int x_axis, int y_axis)
+{
+    // Owned by the dialog through the layout
+    AxisWidget* stick = new AxisWidget(128, 128);
+    stick_hbox.addWidget(stick, 1, Qt::AlignCenter);
     
-    // Always show the stick widgets unless simple_ui is enabled
-    if (!m_simple_ui)
-    {
-        axis_vbox.addLayout(&stick_hbox);
-    }
-    
-    axis_vbox.addLayout(&axis_grid);
-    
-    // Connect signals
-    connect(&joystick, &Joystick::axisChanged, this, &JoystickTestDialog::axisMove);
-    connect(&joystick, &Joystick::buttonChanged, this, &JoystickTestDialog::buttonMove);
-    
-    connect(&calibration_button, &QPushButton::clicked, this, &JoystickTestDialog::onCalibrate);
-    connect(&mapping_button, &QPushButton::clicked, this, &JoystickTestDialog::onMapping);
-    connect(&close_button, &QPushButton::clicked, this, &QDialog::accept);
+    raw_value_callbacks[x_axis] = [stick](int val) { stick->setRawX(val); };
+    raw_value_callbacks[y_axis] = [stick](int val) { stick->setRawY(val); };
+
+    // The cursor is paced, but trail and heatmap get every frame the
+    // stick moved in, with both axes in one point
+    connect(&joystick, &Joystick::frameReady, stick, [stick, x_axis, y_axis](const JoystickFrame& frame) {
+        if (frame.axis_changed[x_axis] || frame.axis_changed[y_axis]) {
+            stick->recordRawPosition(frame.axes[x_axis], frame.axes[y_axis]);
+        }
+    });
+}
+
+void
+JoystickTestDialog::addTrigger(int axis)
+{
+    ThrottleWidget* trigger = new ThrottleWidget(32, 128, true);
+    stick_hbox.addWidget(trigger, 1, Qt::AlignCenter);
     
-    close_button.setFocus();
+    axis_callbacks[axis] = [trigger](double val) { trigger->setPos(val); };
 }
 
-JoystickTestDialog::~JoystickTestDialog()
+void
+JoystickTestDialog::onFrame(const JoystickFrame& frame)
 {
-    // Clean up dynamically allocated widgets
-    delete stick1_widget;
-    delete stick2_widget;
-    delete stick3_widget;
-    delete rudder_widget;
-    delete throttle_widget;
-    delete left_trigger_widget;
-    delete right_trigger_widget;
+    for (int i = 0; i < (int)frame.axis_changed.size(); ++i) {
+        if (frame.axis_changed[i]) {
+            axisMove(i, frame.axes[i]);
+        }
+    }
     
-    // The other widgets (buttons, progress bars, labels) are added to layouts
-    // and will be deleted automatically by Qt's parent-child mechanism
+    for (int i = 0; i < (int)frame.button_changed.size(); ++i) {
+        if (frame.button_changed[i]) {
+            buttonMove(i, frame.buttons[i]);
+        }
+    }
 }
 
 void
 JoystickTestDialog::axisMove(int number, int value)
 {
     // Check that the number is within range
-    if (number >= 0 && number < axes.size()) {
-        // Update progress bar
-        axes.at(number)->setValue((value + 32767) / 655.34);
-        
-        // Update progress bar text with the value
-        QString strValue = QString::number(value);
-        axes.at(number)->setFormat(strValue);
-        
-        // Update value label
-        if (number < axis_value_labels.size()) {
-            axis_value_labels.at(number)->setText(strValue);
-        }
+    if (number >= 0 && number < axis_bank.getAxisCount()) {
+        axis_bank.setValue(number, value);
         
         // Update other widgets
         if (number < axis_callbacks.size()) {
@@ -288,9 +242,7 @@ JoystickTestDialog::axisMove(int number, int value)
 void
 JoystickTestDialog::buttonMove(int number, bool value)
 {
-    if (number >= 0 && number < buttons.size()) {
-        buttons.at(number)->setDown(value);
-    }
+    buttons.setDown(number, value);
 }
 
 void
@@ -22,7 +22,6 @@
 
 #include <QDialog>
 #include <QLabel>
-#include <QProgressBar>
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -32,10 +31,14 @@
 #include <QVector>
 #include <functional>
 
+#include "joystick_frame.h"
+#include "frame_presenter.h"
+#include "widgets/axis_bank_widget.h"
+#include "widgets/button_grid_widget.h"
+
 // Forward declarations to avoid circular dependencies
 class Joystick;
 class JoystickGui;
-class ButtonWidget;
 class AxisWidget;
 class RudderWidget;
 class ThrottleWidget;
@@ -49,6 +52,10 @@ private:
     Joystick& joystick;
     bool m_simple_ui;
 
+    // Device frames go through here, the widgets are updated at most
+    // once per display refresh
+    FramePresenter m_presenter;
+
     QVBoxLayout m_vbox;
     QWidget alignment;
     QLabel label;
@@ -57,7 +64,9 @@ private:
     QVBoxLayout axis_vbox;
     QFrame button_frame;
     QGridLayout axis_grid;
+    AxisBankWidget axis_bank;
     QGridLayout button_grid;
+    ButtonGridWidget buttons;
     QHBoxLayout test_hbox;
     QHBoxLayout stick_hbox;
 
@@ -66,34 +75,29 @@ private:
     QPushButton close_button;
     QHBoxLayout buttonbox;
 
-    // Changed to pointers for forward-declared classes
-    AxisWidget* stick1_widget;
-    AxisWidget* stick2_widget;
-    AxisWidget* stick3_widget;
-
-    RudderWidget* rudder_widget;
-    ThrottleWidget* throttle_widget;
-
-    ThrottleWidget* left_trigger_widget;
-    ThrottleWidget* right_trigger_widget;
-
-    QVector<QProgressBar*> axes;
-    QVector<ButtonWidget*> buttons;
-    QVector<QLabel*> axis_value_labels;
 
     QVector<std::function<void(double)>> axis_callbacks;
     QVector<std::function<void(int)>> raw_value_callbacks;
 
 private slots:
+    void onFrame(const JoystickFrame& frame);
     void axisMove(int number, int value);
     void buttonMove(int number, bool value);
 
     void onCalibrate();
     void onMapping();
 
+private:
+    // Build the graphical view for the axis layout of the device, the
+    // widgets end up owned by the dialog through stick_hbox
+    void createStickWidgets();
+    void addStick(int x_axis, int y_axis);
+    void addTrigger(int axis);
+
 public:
     JoystickTestDialog(JoystickGui& gui, Joystick& joystick, bool simple_ui);
-    ~JoystickTestDialog(); // Need a destructor to clean up pointers
+
+    FramePresenter& getPresenter() { return m_presenter; }
 };
 
 #endif // JSTEST_QT_JOYSTICK_TEST_DIALOG_H
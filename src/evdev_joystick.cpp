@@ -0,0 +1,402 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "evdev_joystick.h"
+
+#include <QDebug>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <stdexcept>
+
+#include "utils/capability_cache.h"
+#include "utils/device_capabilities.h"
+#include "utils/evdev_helper.h"
+#include "utils/sysfs_topology.h"
+
+EvdevJoystick::EvdevJoystick(const std::string& device_path)
+    : Joystick(),
+      m_dropped(false)
+{
+    filename = device_path;
+
+    if ((fd = open(filename.c_str(), O_RDONLY | O_NONBLOCK)) < 0) {
+        QString errorMsg = QString("%1: %2").arg(QString::fromStdString(filename)).arg(strerror(errno));
+        throw std::runtime_error(errorMsg.toStdString());
+    }
+
+    // Everything below comes from this one batch of ioctls
+    DeviceCapabilities caps;
+    if (!caps.read(fd) || !caps.isJoystick()) {
+        throw std::runtime_error(filename + ": not a joystick device");
+    }
+
+    // Default is CLOCK_REALTIME, which jumps with the wall clock
+    int clock_id = CLOCK_MONOTONIC;
+    if (ioctl(fd, EVIOCSCLOCKID, &clock_id) < 0) {
+        qWarning() << "EvdevJoystick: failed to select CLOCK_MONOTONIC on" << QString::fromStdString(filename)
+                   << ":" << strerror(errno);
+    }
+
+    orig_name = caps.name;
+    name = QString::fromUtf8(caps.name.c_str());
+
+    initState(caps);
+
+    startWatching();
+
+    qDebug() << "EvdevJoystick initialized:" << name << "with" << axis_count << "axes and" << button_count << "buttons";
+}
+
+EvdevJoystick::EvdevJoystick()
+    : Joystick(),
+      m_dropped(false)
+{
+    // No axes or buttons until initState()
+    updateLookupTables();
+}
+
+void EvdevJoystick::initState(const DeviceCapabilities& caps)
+{
+    m_axis_mapping = caps.getAxisCodes();
+    m_button_mapping = caps.getButtonCodes();
+
+    axis_count = m_axis_mapping.size();
+    button_count = m_button_mapping.size();
+    updateLookupTables();
+
+    // Axis ranges and current positions
+    m_absinfo.resize(axis_count);
+    m_calibration.resize(axis_count);
+    for (int i = 0; i < axis_count; i++) {
+        m_absinfo[i] = caps.absinfo[m_axis_mapping[i]];
+        m_calibration[i] = absinfo2cal(m_absinfo[i]);
+    }
+    orig_calibration_data = m_calibration;
+    setCalibration(m_calibration);
+
+    axis_state.resize(axis_count);
+    for (int i = 0; i < axis_count; i++) {
+        axis_state[i] = correctValue(m_corr[i], m_absinfo[i].value);
+    }
+
+    // Current button state
+    m_button_state.resize(button_count);
+    for (int i = 0; i < button_count; i++) {
+        m_button_state[i] = caps.key_state.test(m_button_mapping[i]);
+    }
+
+    frame.resize(axis_count, button_count);
+    frame.axes = axis_state;
+    frame.buttons = m_button_state;
+}
+
+EvdevJoystick::~EvdevJoystick()
+{
+    // The reader thread calls our decodeEvents(), stop it while that is
+    // still possible
+    stopReader();
+}
+
+size_t EvdevJoystick::getEventSize() const
+{
+    return sizeof(struct input_event);
+}
+
+void EvdevJoystick::decodeEvents(const void* data, int count, RawEvent* events)
+{
+    const struct input_event* buffer = static_cast<const struct input_event*>(data);
+
+    for (int i = 0; i < count; ++i) {
+        events[i].time  = static_cast<uint64_t>(buffer[i].input_event_sec) * 1000000 + buffer[i].input_event_usec;
+        events[i].type  = buffer[i].type;
+        events[i].code  = buffer[i].code;
+        events[i].value = buffer[i].value;
+    }
+}
+
+void EvdevJoystick::processEvent(const RawEvent& event)
+{
+    if (m_dropped && event.type != EV_SYN) {
+        return;
+    }
+
+    switch (event.type) {
+        case EV_ABS:
+            processAbs(event.code, event.value, event.time);
+            break;
+
+        case EV_KEY:
+            processKey(event.code, event.value, event.time);
+            break;
+
+        case EV_SYN:
+            if (event.code == SYN_REPORT) {
+                if (m_dropped) {
+                    m_dropped = false;
+                    resynchronize(event.time);
+                }
+                else {
+                    flushFrame();
+                }
+            }
+            else if (event.code == SYN_DROPPED) {
+                // The kernel buffer overflowed, the events up to the next
+                // SYN_REPORT are incomplete and have to be ignored
+                if (!m_dropped) {
+                    m_dropped = true;
+                    stat_drops.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void EvdevJoystick::processAbs(int code, int value, uint64_t time)
+{
+    if (code < 0 || code >= ABS_CNT) {
+        return;
+    }
+
+    int axis = m_abs_to_axis[code];
+    if (axis >= 0) {
+        value = correctValue(m_corr[axis], value);
+        if (axis_state[axis] != value) {
+            frameAxis(axis, value, time);
+        }
+    }
+}
+
+void EvdevJoystick::processKey(int code, int value, uint64_t time)
+{
+    if (code < 0 || code >= KEY_CNT) {
+        return;
+    }
+
+    int button = m_key_to_button[code];
+    if (button >= 0) {
+        // value 2 is autorepeat, which still means pressed
+        bool state = (value != 0);
+        if (m_button_state[button] != state) {
+            m_button_state[button] = state;
+            frameButton(button, state, time);
+        }
+    }
+}
+
+const struct input_absinfo* EvdevJoystick::getAbsinfo(int code) const
+{
+    if (code < 0 || code >= ABS_CNT || m_abs_to_axis[code] < 0) {
+        return nullptr;
+    }
+    return &m_absinfo[m_abs_to_axis[code]];
+}
+
+void EvdevJoystick::resynchronize(uint64_t time)
+{
+    for (int i = 0; i < axis_count; i++) {
+        struct input_absinfo absinfo;
+        if (ioctl(fd, EVIOCGABS(m_axis_mapping[i]), &absinfo) < 0) {
+            continue;
+        }
+
+        m_absinfo[i].value = absinfo.value;
+        int value = correctValue(m_corr[i], absinfo.value);
+        if (axis_state[i] != value) {
+            frameAxis(i, value, time);
+        }
+    }
+
+    unsigned long keystate[NLONGS(KEY_CNT)] = { 0 };
+    if (ioctl(fd, EVIOCGKEY(sizeof(keystate)), keystate) >= 0) {
+        for (int i = 0; i < button_count; i++) {
+            int code = m_button_mapping[i];
+            bool state = keystate[BIT_WORD(code)] & BIT_MASK(code);
+            if (m_button_state[i] != state) {
+                m_button_state[i] = state;
+                frameButton(i, state, time);
+            }
+        }
+    }
+
+    // Whatever was left over from before the drop goes out with the
+    // corrected state
+    flushFrame();
+}
+
+bool EvdevJoystick::reopen()
+{
+    if ((fd = open(filename.c_str(), O_RDONLY | O_NONBLOCK)) < 0) {
+        return false;
+    }
+
+    DeviceCapabilities caps;
+    if (!caps.read(fd) || !caps.isJoystick() ||
+        caps.name != orig_name ||
+        caps.getAxisCount() != axis_count ||
+        caps.getButtonCount() != button_count) {
+        return false;
+    }
+
+    int clock_id = CLOCK_MONOTONIC;
+    ioctl(fd, EVIOCSCLOCKID, &clock_id);
+
+    // The calibration and mappings are ours, not the kernel's, so they
+    // carry over as they are. What changed while the device was gone
+    // goes out as a single frame.
+    m_dropped = false;
+    resynchronize(monotonicTime());
+    return true;
+}
+
+void EvdevJoystick::updateLookupTables()
+{
+    m_abs_to_axis.assign(ABS_CNT, -1);
+    for (size_t i = 0; i < m_axis_mapping.size(); i++) {
+        m_abs_to_axis[m_axis_mapping[i]] = i;
+    }
+
+    m_key_to_button.assign(KEY_CNT, -1);
+    for (size_t i = 0; i < m_button_mapping.size(); i++) {
+        m_key_to_button[m_button_mapping[i]] = i;
+    }
+}
+
+std::vector<JoystickDescription> EvdevJoystick::getJoysticks()
+{
+    std::vector<JoystickDescription> joysticks;
+
+    // Capabilities come from sysfs and the capability cache, the devices
+    // themselves only get opened once one is picked
+    SysfsTopology topology;
+    CapabilityCache* cache = CapabilityCache::instance();
+
+    for (const SysfsTopology::InputDevice& device : topology.getDevices()) {
+        if (device.event.empty())
+            continue;
+
+        CapabilityCache::Entry caps = cache->get(device);
+        if (caps.isJoystick()) {
+            joysticks.push_back(JoystickDescription(device.getEventPath(), device.name,
+                                                    caps.axis_count, caps.button_count));
+        }
+    }
+
+    cache->save();
+
+    return joysticks;
+}
+
+std::vector<Joystick::CalibrationData> EvdevJoystick::getCalibration()
+{
+    return m_calibration;
+}
+
+void EvdevJoystick::setCalibration(const std::vector<CalibrationData>& data)
+{
+    if (static_cast<int>(data.size()) != axis_count) {
+        throw std::runtime_error(filename + ": calibration data doesn't match axis count");
+    }
+
+    m_calibration = data;
+    m_corr.resize(axis_count);
+    for (int i = 0; i < axis_count; i++) {
+        m_corr[i] = cal2corr(m_calibration[i]);
+    }
+}
+
+void EvdevJoystick::resetCalibration()
+{
+    setCalibration(orig_calibration_data);
+}
+
+void EvdevJoystick::clearCalibration()
+{
+    std::vector<CalibrationData> data(axis_count);
+    for (auto& cal : data) {
+        cal.calibrate  = false;
+        cal.invert     = false;
+        cal.center_min = 0;
+        cal.center_max = 0;
+        cal.range_min  = 0;
+        cal.range_max  = 0;
+    }
+    setCalibration(data);
+}
+
+std::vector<int> EvdevJoystick::getButtonMapping()
+{
+    return m_button_mapping;
+}
+
+std::vector<int> EvdevJoystick::getAxisMapping()
+{
+    return m_axis_mapping;
+}
+
+void EvdevJoystick::setButtonMapping(const std::vector<int>& mapping)
+{
+    assert(static_cast<int>(mapping.size()) == button_count);
+
+    std::vector<bool> state;
+    for (int code : mapping) {
+        if (code < 0 || code >= KEY_CNT || m_key_to_button[code] < 0) {
+            throw std::runtime_error(filename + ": invalid button mapping");
+        }
+        state.push_back(m_button_state[m_key_to_button[code]]);
+    }
+
+    m_button_mapping = mapping;
+    m_button_state = state;
+    frame.buttons = state;
+    updateLookupTables();
+}
+
+void EvdevJoystick::setAxisMapping(const std::vector<int>& mapping)
+{
+    assert(static_cast<int>(mapping.size()) == axis_count);
+
+    std::vector<struct input_absinfo> absinfo;
+    std::vector<int> state;
+    for (int code : mapping) {
+        if (code < 0 || code >= ABS_CNT || m_abs_to_axis[code] < 0) {
+            throw std::runtime_error(filename + ": invalid axis mapping");
+        }
+        absinfo.push_back(m_absinfo[m_abs_to_axis[code]]);
+        state.push_back(axis_state[m_abs_to_axis[code]]);
+    }
+
+    // Calibration is reordered separately through correctCalibration()
+    m_axis_mapping = mapping;
+    m_absinfo = absinfo;
+    axis_state = state;
+    frame.axes = state;
+    updateLookupTables();
+}
+
+std::string EvdevJoystick::getEvdev() const
+{
+    return filename;
+}
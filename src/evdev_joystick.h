@@ -0,0 +1,108 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_EVDEV_JOYSTICK_H
+#define JSTEST_QT_EVDEV_JOYSTICK_H
+
+#include <QObject>
+#include <string>
+#include <vector>
+#include <linux/input.h>
+
+#include "joystick.h"
+#include "joystick_description.h"
+
+class DeviceCapabilities;
+
+// Reads input_event structs directly from /dev/input/eventN, bypassing
+// the joydev translation layer. Axis and button numbering follows the
+// order joydev would use, so mappings stay comparable between backends.
+class EvdevJoystick : public Joystick
+{
+    Q_OBJECT
+
+private:
+    std::vector<int> m_axis_mapping;    // axis index -> ABS_* code
+    std::vector<int> m_button_mapping;  // button index -> KEY_*/BTN_* code
+    std::vector<int> m_abs_to_axis;     // ABS_* code -> axis index or -1
+    std::vector<int> m_key_to_button;   // KEY_*/BTN_* code -> button index or -1
+
+    std::vector<struct input_absinfo> m_absinfo;
+    std::vector<CalibrationData> m_calibration;
+    std::vector<struct js_corr> m_corr;
+
+    std::vector<bool> m_button_state;
+
+    // Set on SYN_DROPPED, everything up to the next SYN_REPORT is stale
+    bool m_dropped;
+
+public:
+    EvdevJoystick(const std::string& device_path);
+    ~EvdevJoystick() override;
+
+    static std::vector<JoystickDescription> getJoysticks();
+
+    bool hasDriverCalibration() const override { return false; }
+
+    // Calibration methods
+    std::vector<CalibrationData> getCalibration() override;
+    void setCalibration(const std::vector<CalibrationData>& data) override;
+    void resetCalibration() override;
+    void clearCalibration() override;
+
+    // Mapping methods
+    std::vector<int> getButtonMapping() override;
+    std::vector<int> getAxisMapping() override;
+    void setButtonMapping(const std::vector<int>& mapping) override;
+    void setAxisMapping(const std::vector<int>& mapping) override;
+
+    std::string getEvdev() const override;
+
+protected:
+    // For subclasses that get their events some other way, they describe
+    // the device with initState() and feed processAbs() and processKey()
+    EvdevJoystick();
+
+    /** Numbering, ranges, default calibration and current state of all
+        axes and buttons, everything but name and fd */
+    void initState(const DeviceCapabilities& caps);
+
+    /** Apply a raw EV_ABS/EV_KEY value, codes the device doesn't have
+        are ignored */
+    void processAbs(int code, int value, uint64_t time);
+    void processKey(int code, int value, uint64_t time);
+
+    // Kernel range of an ABS_* code, nullptr if the device doesn't have it
+    const struct input_absinfo* getAbsinfo(int code) const;
+
+    size_t getEventSize() const override;
+    void decodeEvents(const void* data, int count, RawEvent* events) override;
+    void processEvent(const RawEvent& event) override;
+    void resynchronize(uint64_t time) override;
+    bool reopen() override;
+
+private:
+    // Rebuild the code -> index lookup tables from the mappings
+    void updateLookupTables();
+
+    // Prohibit copying
+    EvdevJoystick(const EvdevJoystick&) = delete;
+    EvdevJoystick& operator=(const EvdevJoystick&) = delete;
+};
+
+#endif // JSTEST_QT_EVDEV_JOYSTICK_H
@@ -0,0 +1,213 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "frame_presenter.h"
+
+#include <QScreen>
+#include <QWidget>
+#include <algorithm>
+#include <assert.h>
+
+int FramePresenter::s_default_max_fps = FramePresenter::DISPLAY_RATE;
+
+void
+FramePresenter::setDefaultMaxFps(int max_fps)
+{
+    s_default_max_fps = max_fps;
+}
+
+int
+FramePresenter::getDefaultMaxFps()
+{
+    return s_default_max_fps;
+}
+
+FramePresenter::FramePresenter(QWidget* widget, int axis_count, int button_count)
+    : QObject(nullptr),
+      m_widget(widget),
+      m_max_fps(s_default_max_fps),
+      m_pending(),
+      m_deferred_release(button_count, false),
+      m_has_deferred(false),
+      m_timer(),
+      m_clock(),
+      m_next_present_ns(-1),
+      m_latch_count(0),
+      m_present_count(0)
+{
+    m_pending.resize(axis_count, button_count);
+
+    m_clock.start();
+
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &FramePresenter::present);
+}
+
+void
+FramePresenter::setMaxFps(int max_fps)
+{
+    m_max_fps = max_fps;
+
+    // Don't keep a frame back that would now go out right away
+    if (m_max_fps == UNPACED && m_timer.isActive())
+    {
+        m_timer.stop();
+        present();
+    }
+}
+
+double
+FramePresenter::getRate() const
+{
+    if (m_max_fps == UNPACED)
+    {
+        return 0.0;
+    }
+
+    double display_rate = FALLBACK_RATE;
+    QScreen* screen = m_widget ? m_widget->screen() : nullptr;
+    if (screen && screen->refreshRate() >= 1.0)
+    {
+        display_rate = screen->refreshRate();
+    }
+
+    if (m_max_fps == DISPLAY_RATE)
+    {
+        return display_rate;
+    }
+
+    return std::min(display_rate, double(m_max_fps));
+}
+
+void
+FramePresenter::latch(const JoystickFrame& frame)
+{
+    m_latch_count += 1;
+
+    if (m_max_fps == UNPACED)
+    {
+        m_present_count += 1;
+        emit frameReady(frame);
+        return;
+    }
+
+    for (int i = 0; i < (int)frame.axis_changed.size() && i < (int)m_pending.axes.size(); ++i)
+    {
+        if (frame.axis_changed[i])
+        {
+            m_pending.setAxis(i, frame.axes[i]);
+        }
+    }
+
+    for (int i = 0; i < (int)frame.button_changed.size() && i < (int)m_pending.buttons.size(); ++i)
+    {
+        if (!frame.button_changed[i])
+        {
+            continue;
+        }
+
+        if (m_pending.button_changed[i] && m_pending.buttons[i] && !frame.buttons[i])
+        {
+            // Pressed and released within one refresh, show the press first
+            m_deferred_release[i] = true;
+            m_has_deferred = true;
+        }
+        else
+        {
+            m_deferred_release[i] = false;
+            m_pending.setButton(i, frame.buttons[i]);
+        }
+    }
+
+    m_pending.time = frame.time;
+
+    if (!m_timer.isActive())
+    {
+        schedule();
+    }
+}
+
+void
+FramePresenter::schedule()
+{
+    // Only ever called when paced, getRate() is 0 otherwise
+    assert(m_max_fps != UNPACED);
+
+    const qint64 interval_ns = qint64(1e9 / getRate());
+    const qint64 now_ns = m_clock.nsecsElapsed();
+
+    // After a quiet period the first change goes out right away, but
+    // missed deadlines aren't caught up with a burst of frames
+    if (m_next_present_ns < 0 || now_ns - m_next_present_ns > interval_ns)
+    {
+        m_next_present_ns = now_ns;
+    }
+
+    int delay_ms = 0;
+    if (m_next_present_ns > now_ns)
+    {
+        delay_ms = int((m_next_present_ns - now_ns + 999999) / 1000000);
+    }
+
+    m_timer.start(delay_ms);
+}
+
+void
+FramePresenter::present()
+{
+    // From the deadline, not from now, the timer fires up to a
+    // millisecond late
+    if (m_max_fps != UNPACED)
+    {
+        m_next_present_ns += qint64(1e9 / getRate());
+    }
+
+    if (!m_pending.isEmpty())
+    {
+        m_present_count += 1;
+        emit frameReady(m_pending);
+        m_pending.clearChanges();
+    }
+
+    if (m_has_deferred)
+    {
+        for (int i = 0; i < (int)m_deferred_release.size(); ++i)
+        {
+            if (m_deferred_release[i])
+            {
+                m_pending.setButton(i, false);
+                m_deferred_release[i] = false;
+            }
+        }
+        m_has_deferred = false;
+
+        if (m_max_fps == UNPACED)
+        {
+            // setMaxFps() flushed us, there is no refresh left to wait
+            // for, so the releases go out right behind the presses
+            m_present_count += 1;
+            emit frameReady(m_pending);
+            m_pending.clearChanges();
+        }
+        else
+        {
+            schedule();
+        }
+    }
+}
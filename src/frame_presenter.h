@@ -0,0 +1,110 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_FRAME_PRESENTER_H
+#define JSTEST_QT_FRAME_PRESENTER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <vector>
+
+#include "joystick_frame.h"
+
+class QWidget;
+
+/**
+ * Paces joystick frames to the display. Frames passed to latch() are
+ * merged into a pending frame, which is handed on with frameReady() at
+ * most once per display refresh, so a device sending 1000 events per
+ * second doesn't update the widgets more often than the screen can
+ * show. When nothing changes the presenter stays idle, and the first
+ * change after a quiet period goes out right away.
+ *
+ * A button that is pressed and released again within the same refresh
+ * is presented as pressed for one frame instead of not at all.
+ */
+class FramePresenter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** Present at the refresh rate of the screen the widget is on */
+    static const int DISPLAY_RATE = -1;
+
+    /** Hand on every frame as it comes in */
+    static const int UNPACED = 0;
+
+    /** Refresh rate assumed when the screen doesn't report one */
+    static const int FALLBACK_RATE = 60;
+
+    /** max_fps for presenters created afterwards, DISPLAY_RATE, UNPACED
+        or an upper limit in Hz, the display rate is never exceeded */
+    static void setDefaultMaxFps(int max_fps);
+    static int getDefaultMaxFps();
+
+    FramePresenter(QWidget* widget, int axis_count, int button_count);
+
+    void setMaxFps(int max_fps);
+    int getMaxFps() const { return m_max_fps; }
+
+    /** Updates per second currently used, 0 when unpaced */
+    double getRate() const;
+
+    uint64_t getLatchCount() const { return m_latch_count; }
+    uint64_t getPresentCount() const { return m_present_count; }
+
+public slots:
+    void latch(const JoystickFrame& frame);
+
+signals:
+    /** Same as Joystick::frameReady(), but paced */
+    void frameReady(const JoystickFrame& frame);
+
+private:
+    void schedule();
+    void present();
+
+    static int s_default_max_fps;
+
+    QWidget* m_widget;
+    int m_max_fps;
+
+    JoystickFrame m_pending;
+
+    // Releases of buttons whose press hasn't been presented yet
+    std::vector<bool> m_deferred_release;
+    bool m_has_deferred;
+
+    QTimer m_timer;
+
+    // When the next frame is due, in nanoseconds on m_clock. Deadlines
+    // advance by the exact interval while QTimer only does whole
+    // milliseconds, so the rounding doesn't add up over many frames.
+    QElapsedTimer m_clock;
+    qint64 m_next_present_ns;
+
+    uint64_t m_latch_count;
+    uint64_t m_present_count;
+
+    // Prohibit copying
+    FramePresenter(const FramePresenter&) = delete;
+    FramePresenter& operator=(const FramePresenter&) = delete;
+};
+
+#endif // JSTEST_QT_FRAME_PRESENTER_H
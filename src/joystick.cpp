@@ -27,22 +27,40 @@
 #include <stdint.h>
 #include <string.h>
 #include <errno.h>
+#include <time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <linux/joystick.h>
+#include <linux/input.h>
 #include <QFile>
 #include <QDir>
 #include <QDebug>
 
+#include "joystick_event_hub.h"
+#include "joystick_reader.h"
+#ifdef HAVE_LIBURING
+#  include "joystick_uring.h"
+#endif
+#include "utils/capability_cache.h"
 #include "utils/evdev_helper.h"
+#include "utils/sysfs_topology.h"
+
+static_assert(sizeof(struct js_event) <= Joystick::MAX_EVENT_SIZE &&
+              sizeof(struct input_event) <= Joystick::MAX_EVENT_SIZE,
+              "MAX_EVENT_SIZE too small");
 
 // Protected constructor for derived classes
 Joystick::Joystick()
     : QObject(nullptr),
       fd(-1),
-      notifier(nullptr)
+      stat_syscalls(0),
+      stat_events(0),
+      stat_drops(0),
+      last_event_time(0),
+      reader(),
+      reader_overflows_seen(0)
 {
     // Initialize with default values
     // Derived classes should set these appropriately
@@ -52,7 +70,13 @@ Joystick::Joystick()
 
 Joystick::Joystick(const std::string& filename_)
     : QObject(nullptr),
-      filename(filename_)
+      filename(filename_),
+      stat_syscalls(0),
+      stat_events(0),
+      stat_drops(0),
+      last_event_time(0),
+      reader(),
+      reader_overflows_seen(0)
 {
     // Use non-blocking mode for better compatibility with Wayland
     if ((fd = open(filename.c_str(), O_RDONLY | O_NONBLOCK)) < 0)
@@ -84,36 +108,33 @@ Joystick::Joystick(const std::string& filename_)
         }
 
         axis_state.resize(axis_count);
+        frame.resize(axis_count, button_count);
     }
 
     orig_calibration_data = getCalibration();
+    calibration_data = orig_calibration_data;
+
+    startWatching();
 
-    // Create QSocketNotifier with more robust error handling
-    notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
-    if (!notifier) {
-        close(fd);
-        throw std::runtime_error("Failed to create socket notifier");
-    }
-    
-    // Use direct connection for better reliability with Wayland
-    connect(notifier, &QSocketNotifier::activated, this, &Joystick::onSocketActivated, 
-            Qt::DirectConnection);
-            
-    // Make sure the notifier is enabled
-    notifier->setEnabled(true);
-    
     qDebug() << "Joystick initialized:" << name << "with" << axis_count << "axes and" << button_count << "buttons";
 }
 
 Joystick::~Joystick()
 {
-    // Disable notifier before destruction to prevent activated signal during deletion
-    if (notifier) {
-        notifier->setEnabled(false);
-        delete notifier;
-        notifier = nullptr;
+    // The reader thread uses fd, so it has to go first
+    stopReader();
+
+    ReadStats stats = getReadStats();
+    if (stats.syscalls > 0) {
+        qDebug() << "Joystick read stats:" << name << stats.syscalls << "syscalls,"
+                 << stats.events << "events," << stats.eventsPerRead() << "events/read,"
+                 << stats.overflows << "overflows," << stats.drops << "drops";
     }
-    
+
+    // Has to happen before the fd is closed, epoll would keep it around
+    // otherwise
+    stopWatching();
+
     if (fd >= 0) {
         close(fd);
         fd = -1;
@@ -121,52 +142,413 @@ Joystick::~Joystick()
 }
 
 void
-Joystick::onSocketActivated(int socket)
+Joystick::startWatching()
 {
-    if (socket == fd) {
-        update();
+    if (fd < 0) {
+        return;
     }
+
+#ifdef HAVE_LIBURING
+    JoystickUring* uring = JoystickUring::instance();
+    if (uring) {
+        size_t event_size = getEventSize();
+        size_t len = (JoystickUring::BUFFER_SIZE / event_size) * event_size;
+        bool ok = uring->addRead(fd, len, [this](const char* data, int result) {
+            if (result < 0) {
+                QString errorMsg = QString("%1: %2").arg(QString::fromStdString(filename)).arg(strerror(-result));
+                qWarning() << "Error reading from joystick:" << errorMsg;
+                throw std::runtime_error(errorMsg.toStdString());
+            }
+            processData(data, result);
+        });
+        if (ok) {
+            return;
+        }
+        qWarning() << "No free io_uring slot for" << name << ", falling back to read()";
+    }
+#endif
+
+    JoystickEventHub::instance()->addWatch(fd, [this]() { update(); });
+}
+
+void
+Joystick::stopWatching()
+{
+    if (fd < 0) {
+        return;
+    }
+
+#ifdef HAVE_LIBURING
+    if (JoystickUring* uring = JoystickUring::instance()) {
+        uring->removeRead(fd);
+    }
+#endif
+
+    JoystickEventHub::instance()->removeWatch(fd);
 }
 
 void
 Joystick::update()
 {
-    struct js_event event;
+    RawEvent events[EVENT_BATCH_SIZE];
+    int count;
+
+    // A short read means the kernel queue is empty, no need to spend
+    // another syscall just to get EAGAIN back
+    do {
+        count = readEvents(events, EVENT_BATCH_SIZE);
+        for (int i = 0; i < count; ++i) {
+            processEvent(events[i]);
+        }
+    } while (count == EVENT_BATCH_SIZE);
 
-    // We might get multiple events, process all of them
-    while (true) {
-        ssize_t len = read(fd, &event, sizeof(event));
-        
-        if (len < 0) {
-            // EAGAIN is expected with non-blocking mode when no more events
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                break;
-            }
-            
-            QString errorMsg = QString("%1: %2").arg(QString::fromStdString(filename)).arg(strerror(errno));
-            qWarning() << "Error reading from joystick:" << errorMsg;
-            throw std::runtime_error(errorMsg.toStdString());
+    flushFrame();
+}
+
+int
+Joystick::readEvents(RawEvent* events, int max)
+{
+    // The kernel hands out as many whole events as fit into the buffer
+    alignas(8) char buffer[EVENT_BATCH_SIZE * MAX_EVENT_SIZE];
+    size_t event_size = getEventSize();
+    max = std::min(max, static_cast<int>(EVENT_BATCH_SIZE));
+
+    ssize_t len = read(fd, buffer, max * event_size);
+    stat_syscalls.fetch_add(1, std::memory_order_relaxed);
+
+    if (len < 0) {
+        // EAGAIN is expected with non-blocking mode when no more events
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
         }
-        else if (len == 0) {
-            // End of file
-            break;
+
+        QString errorMsg = QString("%1: %2").arg(QString::fromStdString(filename)).arg(strerror(errno));
+        qWarning() << "Error reading from joystick:" << errorMsg;
+        throw std::runtime_error(errorMsg.toStdString());
+    }
+    else if (len % event_size != 0) {
+        throw std::runtime_error("Joystick::readEvents(): incomplete read");
+    }
+
+    int count = len / event_size;
+    stat_events.fetch_add(count, std::memory_order_relaxed);
+
+    decodeEvents(buffer, count, events);
+    return count;
+}
+
+size_t
+Joystick::getEventSize() const
+{
+    return sizeof(struct js_event);
+}
+
+void
+Joystick::decodeEvents(const void* data, int count, RawEvent* events)
+{
+    const struct js_event* buffer = static_cast<const struct js_event*>(data);
+
+    // js_event.time is a 32bit millisecond jiffies counter that can't be
+    // compared with anything else, so anchor the newest event of the
+    // batch at the time of the read and keep the kernel spacing for the
+    // rest of them
+    uint64_t now = monotonicTime();
+    uint32_t newest = count > 0 ? buffer[count - 1].time : 0;
+
+    for (int i = 0; i < count; ++i) {
+        uint64_t age = static_cast<uint64_t>(newest - buffer[i].time) * 1000;
+        uint64_t time = now > age ? now - age : 0;
+        if (time < last_event_time) {
+            time = last_event_time;
         }
-        else if (len == sizeof(event)) {
-            // Process the event
-            if (event.type & JS_EVENT_AXIS) {
-                if (event.number < axis_state.size()) {
-                    axis_state[event.number] = event.value;
-                    emit axisChanged(event.number, event.value);
-                }
-            }
-            else if (event.type & JS_EVENT_BUTTON) {
-                emit buttonChanged(event.number, event.value);
-            }
+        last_event_time = time;
+
+        events[i].time  = time;
+        events[i].type  = buffer[i].type;
+        events[i].code  = buffer[i].number;
+        events[i].value = buffer[i].value;
+    }
+}
+
+void
+Joystick::processData(const char* data, size_t len)
+{
+    size_t event_size = getEventSize();
+    if (len % event_size != 0) {
+        throw std::runtime_error("Joystick::processData(): incomplete read");
+    }
+
+    RawEvent events[EVENT_BATCH_SIZE];
+    size_t total = len / event_size;
+    stat_events.fetch_add(total, std::memory_order_relaxed);
+
+    for (size_t offset = 0; offset < total; offset += EVENT_BATCH_SIZE) {
+        int count = static_cast<int>(std::min(total - offset, static_cast<size_t>(EVENT_BATCH_SIZE)));
+        decodeEvents(data + offset * event_size, count, events);
+        for (int i = 0; i < count; ++i) {
+            processEvent(events[i]);
+        }
+    }
+
+    flushFrame();
+}
+
+void
+Joystick::processEvent(const RawEvent& event)
+{
+    if (event.type & JS_EVENT_AXIS) {
+        if (event.code < axis_count) {
+            frameAxis(event.code, event.value, event.time);
+        }
+    }
+    else if (event.type & JS_EVENT_BUTTON) {
+        if (event.code < button_count) {
+            frameButton(event.code, event.value, event.time);
+        }
+    }
+}
+
+bool
+Joystick::setThreadedReading(bool enable)
+{
+    if (enable == isThreadedReading()) {
+        return true;
+    }
+
+    if (enable) {
+        if (!supportsThreadedReading() || fd < 0) {
+            return false;
+        }
+
+        reader = std::make_unique<JoystickReader>(fd, [this](RawEvent* events, int max) {
+            return readEvents(events, max);
+        });
+
+        reader_overflows_seen = 0;
+
+        // The reader thread polls fd itself, the hub only has to wait
+        // for its wakeups
+        stopWatching();
+        JoystickEventHub::instance()->addWatch(reader->getWakeFd(), [this]() { onReaderActivated(); });
+        reader->start();
+    }
+    else {
+        reader->stop();
+
+        // Process whatever the thread managed to queue up
+        onReaderActivated();
+
+        JoystickEventHub::instance()->removeWatch(reader->getWakeFd());
+        reader.reset();
+
+        startWatching();
+    }
+
+    return true;
+}
+
+void
+Joystick::stopReader()
+{
+    if (!reader) {
+        return;
+    }
+
+    reader->stop();
+    JoystickEventHub::instance()->removeWatch(reader->getWakeFd());
+    reader.reset();
+}
+
+void
+Joystick::onReaderActivated()
+{
+    reader->acknowledge();
+
+    RawEvent event;
+    while (reader->pop(event)) {
+        processEvent(event);
+    }
+    flushFrame();
+
+    // A full ring loses events just like a full kernel buffer does
+    uint64_t overflows = reader->getOverflowCount();
+    if (overflows != reader_overflows_seen) {
+        reader_overflows_seen = overflows;
+        stat_drops.fetch_add(1, std::memory_order_relaxed);
+        resynchronize(monotonicTime());
+    }
+
+    if (reader->hasFailed()) {
+        qWarning() << "Reader thread for" << name << "stopped";
+        JoystickEventHub::instance()->removeWatch(reader->getWakeFd());
+    }
+}
+
+Joystick::ReadStats
+Joystick::getReadStats() const
+{
+    ReadStats stats;
+    stats.syscalls  = stat_syscalls.load(std::memory_order_relaxed);
+    stats.events    = stat_events.load(std::memory_order_relaxed);
+    stats.overflows = reader ? reader->getOverflowCount() : 0;
+    stats.drops     = stat_drops.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void
+Joystick::resynchronize(uint64_t /*time*/)
+{
+}
+
+bool
+Joystick::reconnect()
+{
+    if (!supportsReconnect()) {
+        return false;
+    }
+
+    bool threaded = isThreadedReading();
+    setThreadedReading(false);
+    stopWatching();
+
+    // The old fd stays until the new one checked out
+    int old_fd = fd;
+    fd = -1;
+
+    if (!reopen()) {
+        if (fd >= 0) {
+            close(fd);
         }
-        else {
-            throw std::runtime_error("Joystick::update(): incomplete read");
+        fd = old_fd;
+        startWatching();
+        if (threaded) {
+            setThreadedReading(true);
         }
+        qWarning() << "Joystick: failed to reconnect" << QString::fromStdString(filename);
+        return false;
+    }
+
+    if (old_fd >= 0) {
+        close(old_fd);
+    }
+
+    // The event node may have a different number now
+    evdev_path.clear();
+
+    startWatching();
+    if (threaded) {
+        setThreadedReading(true);
+    }
+
+    qDebug() << "Joystick reconnected:" << name;
+    return true;
+}
+
+bool
+Joystick::reopen()
+{
+    if ((fd = open(filename.c_str(), O_RDONLY | O_NONBLOCK)) < 0) {
+        return false;
+    }
+
+    uint8_t num_axis   = 0;
+    uint8_t num_button = 0;
+    if (ioctl(fd, JSIOCGAXES, &num_axis) < 0 ||
+        ioctl(fd, JSIOCGBUTTONS, &num_button) < 0 ||
+        num_axis != axis_count || num_button != button_count) {
+        return false;
+    }
+
+    // Another pad with the same number of axes and buttons must not get
+    // this one's calibration
+    char name_c_str[1024];
+    if (ioctl(fd, JSIOCGNAME(sizeof(name_c_str)), name_c_str) < 0 ||
+        orig_name != name_c_str) {
+        return false;
+    }
+
+    // joydev starts out with the driver defaults again, the axes report
+    // their state with the JS_EVENT_INIT events of the new fd. The old
+    // fd can't be asked anymore, so the calibration the user had comes
+    // from what we last set. The driver defaults only replace the old
+    // ones once nothing can fail anymore, the old fd comes back otherwise.
+    std::vector<CalibrationData> driver_calibration;
+    try {
+        driver_calibration = getCalibration();
+        setCalibration(calibration_data);
+    } catch (const std::exception& err) {
+        qWarning() << "Joystick: failed to restore calibration:" << err.what();
+        return false;
+    }
+    orig_calibration_data = driver_calibration;
+    return true;
+}
+
+void
+Joystick::frameAxis(int number, int value, uint64_t time)
+{
+    axis_state[number] = value;
+    frame.setAxis(number, value);
+    frame.time = time;
+    emit axisChanged(number, value, time);
+}
+
+void
+Joystick::frameButton(int number, bool value, uint64_t time)
+{
+    frame.setButton(number, value);
+    frame.time = time;
+    emit buttonChanged(number, value, time);
+}
+
+void
+Joystick::flushFrame()
+{
+    if (!frame.isEmpty())
+    {
+        emit frameReady(frame);
+        frame.clearChanges();
+    }
+}
+
+int
+Joystick::correctValue(const struct js_corr& corr, int value)
+{
+    if (!corr.type)
+    {
+        return value;
+    }
+
+    int64_t result;
+    if (value > corr.coef[0])
+    {
+        if (value < corr.coef[1])
+            result = 0;
+        else
+            result = (static_cast<int64_t>(corr.coef[3]) * (value - corr.coef[1])) >> 14;
+    }
+    else
+    {
+        result = (static_cast<int64_t>(corr.coef[2]) * (value - corr.coef[0])) >> 14;
     }
+
+    return static_cast<int>(std::clamp<int64_t>(result, -32767, 32767));
+}
+
+void
+Joystick::resetReadStats()
+{
+    stat_syscalls.store(0);
+    stat_events.store(0);
+    stat_drops.store(0);
+}
+
+uint64_t
+Joystick::monotonicTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
 }
 
 std::vector<JoystickDescription>
@@ -185,12 +567,7 @@ Joystick::getJoysticks()
             if (devDir.exists(joystickPath))
             {
                 QString fullPath = devDir.filePath(joystickPath);
-                Joystick joystick(fullPath.toStdString());
-
-                joysticks.push_back(JoystickDescription(joystick.getFilename(),
-                                                       joystick.getName().toStdString(),
-                                                       joystick.getAxisCount(),
-                                                       joystick.getButtonCount()));
+                joysticks.push_back(probe(fullPath.toStdString()));
             }
         }
         catch(std::exception& err)
@@ -199,106 +576,65 @@ Joystick::getJoysticks()
         }
     }
 
-    // If no joysticks found using the traditional method, try alternative detection
+    // If no joysticks found using the traditional method, fall back to the
+    // evdev devices. Everything needed is in sysfs, so nothing gets opened
+    // and each device is paired with its js node through the input device
+    // they both belong to instead of by comparing names.
     if (joysticks.empty())
     {
-        // First try with evdev directly
-        QDir evdevDir("/dev/input");
-        QStringList filters;
-        filters << "event*";
-        evdevDir.setNameFilters(filters);
-        QStringList eventDevices = evdevDir.entryList();
-        
-        for (const QString& eventDevice : eventDevices)
+        SysfsTopology topology;
+        CapabilityCache* cache = CapabilityCache::instance();
+
+        for (const SysfsTopology::InputDevice& device : topology.getDevices())
         {
-            QString fullPath = evdevDir.filePath(eventDevice);
-            int fd = open(fullPath.toStdString().c_str(), O_RDONLY | O_NONBLOCK);
-            
-            if (fd >= 0)
+            if (device.event.empty())
+                continue;
+
+            CapabilityCache::Entry caps = cache->get(device);
+            if (caps.isJoystick() && caps.axis_count > 0 && caps.button_count > 0)
             {
-                uint8_t evbit[EV_MAX/8 + 1];
-                memset(evbit, 0, sizeof(evbit));
-                
-                if (ioctl(fd, EVIOCGBIT(0, sizeof(evbit)), evbit) >= 0)
-                {
-                    // Check if this device has joystick-like capabilities
-                    if ((evbit[EV_ABS/8] & (1 << (EV_ABS % 8))) &&
-                        (evbit[EV_KEY/8] & (1 << (EV_KEY % 8))))
-                    {
-                        // Looks like it might be a joystick - get more information
-                        char name[256] = "Unknown";
-                        if (ioctl(fd, EVIOCGNAME(sizeof(name)), name) >= 0)
-                        {
-                            // Get axis and button counts
-                            uint8_t absbit[ABS_MAX/8 + 1];
-                            uint8_t keybit[KEY_MAX/8 + 1];
-                            memset(absbit, 0, sizeof(absbit));
-                            memset(keybit, 0, sizeof(keybit));
-                            
-                            ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absbit)), absbit);
-                            ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keybit)), keybit);
-                            
-                            // Count axes and buttons
-                            int axis_count = 0;
-                            for (int i = 0; i < ABS_MAX; i++) {
-                                if (absbit[i/8] & (1 << (i % 8))) {
-                                    axis_count++;
-                                }
-                            }
-                            
-                            int button_count = 0;
-                            for (int i = BTN_JOYSTICK; i < KEY_MAX; i++) {
-                                if (keybit[i/8] & (1 << (i % 8))) {
-                                    button_count++;
-                                }
-                            }
-                            
-                            if (axis_count > 0 && button_count > 0) {
-                                // Transform evdev path to joystick path if possible
-                                QDir jsDevDir("/dev/input");
-                                QString joystickPath;
-                                
-                                // Find corresponding js device by matching device name
-                                for (int i = 0; i < 32; i++) {
-                                    QString jsPath = QString("js%1").arg(i);
-                                    if (jsDevDir.exists(jsPath)) {
-                                        QString fullJsPath = jsDevDir.filePath(jsPath);
-                                        int js_fd = open(fullJsPath.toStdString().c_str(), O_RDONLY | O_NONBLOCK);
-                                        if (js_fd >= 0) {
-                                            char js_name[256] = "";
-                                            if (ioctl(js_fd, JSIOCGNAME(sizeof(js_name)), js_name) >= 0) {
-                                                if (strcmp(name, js_name) == 0) {
-                                                    joystickPath = fullJsPath;
-                                                    close(js_fd);
-                                                    break;
-                                                }
-                                            }
-                                            close(js_fd);
-                                        }
-                                    }
-                                }
-                                
-                                // If no matching js device found, use the event device
-                                if (joystickPath.isEmpty()) {
-                                    joystickPath = fullPath;
-                                }
-                                
-                                joysticks.push_back(JoystickDescription(joystickPath.toStdString(),
-                                                                      name,
-                                                                      axis_count,
-                                                                      button_count));
-                            }
-                        }
-                    }
-                }
-                close(fd);
+                std::string path = device.js.empty() ? device.getEventPath() : device.getJsPath();
+                joysticks.push_back(JoystickDescription(path,
+                                                        device.name,
+                                                        caps.axis_count,
+                                                        caps.button_count));
             }
         }
+
+        cache->save();
     }
 
     return joysticks;
 }
 
+JoystickDescription
+Joystick::probe(const std::string& filename)
+{
+    int probe_fd = open(filename.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (probe_fd < 0)
+    {
+        QString errorMsg = QString("%1: %2").arg(QString::fromStdString(filename)).arg(strerror(errno));
+        throw std::runtime_error(errorMsg.toStdString());
+    }
+
+    uint8_t num_axis   = 0;
+    uint8_t num_button = 0;
+    ioctl(probe_fd, JSIOCGAXES,    &num_axis);
+    ioctl(probe_fd, JSIOCGBUTTONS, &num_button);
+
+    char name_c_str[1024];
+    if (ioctl(probe_fd, JSIOCGNAME(sizeof(name_c_str)), name_c_str) < 0)
+    {
+        QString errorMsg = QString("%1: %2").arg(QString::fromStdString(filename)).arg(strerror(errno));
+        close(probe_fd);
+        throw std::runtime_error(errorMsg.toStdString());
+    }
+
+    close(probe_fd);
+
+    return JoystickDescription(filename, name_c_str, num_axis, num_button);
+}
+
 Joystick::CalibrationData corr2cal(const struct js_corr& corr_)
 {
     struct js_corr corr = corr_;
@@ -354,6 +690,26 @@ Joystick::getCalibration()
     }
 }
 
+Joystick::CalibrationData absinfo2cal(const struct input_absinfo& absinfo)
+{
+    Joystick::CalibrationData data;
+
+    int center = (absinfo.minimum + absinfo.maximum) / 2;
+    int flat = absinfo.flat;
+    if (center - flat <= absinfo.minimum || center + flat >= absinfo.maximum) {
+        flat = 0;
+    }
+
+    data.calibrate  = true;
+    data.invert     = false;
+    data.center_min = center - flat;
+    data.center_max = center + flat;
+    data.range_min  = absinfo.minimum;
+    data.range_max  = absinfo.maximum;
+
+    return data;
+}
+
 struct js_corr cal2corr(const Joystick::CalibrationData& data)
 {
     struct js_corr corr;
@@ -398,6 +754,8 @@ Joystick::setCalibration(const std::vector<CalibrationData>& data)
         QString errorMsg = QString("%1: %2").arg(QString::fromStdString(filename)).arg(strerror(errno));
         throw std::runtime_error(errorMsg.toStdString());
     }
+
+    calibration_data = data;
 }
 
 void
@@ -531,36 +889,14 @@ Joystick::correctCalibration(const std::vector<int>& mapping_old, const std::vec
 std::string
 Joystick::getEvdev() const
 {
-    // See /usr/share/doc/linux-doc-2.6.28/devices.txt.gz
-    for(int i = 0; i < 32; ++i)
+    if (evdev_path.empty())
     {
-        QString eventPath = QString("/dev/input/event%1").arg(i);
-
-        int evdev_fd;
-        if ((evdev_fd = open(eventPath.toStdString().c_str(), O_RDONLY)) < 0)
-        {
-            // ignore
-        }
-        else
+        evdev_path = SysfsTopology::findSibling(filename, "event");
+        if (evdev_path.empty())
         {
-            char evdev_name[256];
-            if (ioctl(evdev_fd, EVIOCGNAME(sizeof(evdev_name)), evdev_name) < 0)
-            {
-                std::cout << eventPath.toStdString() << ": " << strerror(errno) << std::endl;
-            }
-            else
-            {
-                if (orig_name == evdev_name)
-                {
-                    // Found a device that matches, so return it
-                    close(evdev_fd);
-                    return eventPath.toStdString();
-                }
-            }
-
-            close(evdev_fd);
+            throw std::runtime_error("couldn't find evdev for " + filename);
         }
     }
 
-    throw std::runtime_error("couldn't find evdev for " + filename);
+    return evdev_path;
 }
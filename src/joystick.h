@@ -21,12 +21,18 @@
 #define JSTEST_QT_JOYSTICK_H
 
 #include <QObject>
-#include <QSocketNotifier>
 #include <QString>
+#include <atomic>
+#include <memory>
 #include <vector>
+#include <stdint.h>
 #include <linux/joystick.h>
 
 #include "joystick_description.h"
+#include "joystick_frame.h"
+
+class JoystickReader;
+struct input_absinfo;
 
 class Joystick : public QObject
 {
@@ -42,11 +48,40 @@ public:
         int range_max;
     };
 
+    /** A device event decoded from the backend specific wire format,
+        time is in microseconds on CLOCK_MONOTONIC */
+    struct RawEvent {
+        uint64_t time;
+        uint16_t type;
+        uint16_t code;
+        int32_t value;
+    };
+
+    /** Maximum number of events fetched with a single read() */
+    static const int EVENT_BATCH_SIZE = 64;
+
+    /** Largest wire format event of any backend, struct input_event */
+    static const int MAX_EVENT_SIZE = 24;
+
+    /** Counters for the event read path, used to see how many events
+        get delivered per read() syscall */
+    struct ReadStats {
+        uint64_t syscalls;
+        uint64_t events;
+        uint64_t overflows;  // events dropped by the reader thread
+        uint64_t drops;      // times the state had to be resynchronized
+
+        double eventsPerRead() const { return syscalls ? double(events) / double(syscalls) : 0.0; }
+    };
+
 protected:
     int fd;
 
     std::string filename;
     std::string orig_name;
+
+    // Result of getEvdev(), resolved on first use
+    mutable std::string evdev_path;
     QString name;
     int axis_count;
     int button_count;
@@ -54,7 +89,24 @@ protected:
     std::vector<int> axis_state;
     std::vector<CalibrationData> orig_calibration_data;
 
-    QSocketNotifier* notifier;
+    // joydev: the last calibration that went into the kernel, the kernel
+    // forgets it when the device is unplugged
+    std::vector<CalibrationData> calibration_data;
+
+    // Updated from the reader thread when threaded reading is enabled
+    std::atomic<uint64_t> stat_syscalls;
+    std::atomic<uint64_t> stat_events;
+    std::atomic<uint64_t> stat_drops;
+
+    // Newest timestamp handed out by readEvents(), keeps the joydev
+    // timestamps from going backwards between reads
+    uint64_t last_event_time;
+
+    // State collected since the last frameReady()
+    JoystickFrame frame;
+
+    std::unique_ptr<JoystickReader> reader;
+    uint64_t reader_overflows_seen;
 
 public:
     Joystick(const std::string& filename);
@@ -65,6 +117,25 @@ public:
 
     virtual void update();
 
+    /** Read the device on a dedicated thread, events are queued in a
+        lock-free ring and processed whenever the GUI thread gets to
+        them. Returns false if the backend can't do that. */
+    bool setThreadedReading(bool enable);
+    bool isThreadedReading() const { return reader != nullptr; }
+    virtual bool supportsThreadedReading() const { return true; }
+
+    /** Open the device node again after it was unplugged and plugged
+        back in, so whoever holds on to this Joystick keeps working.
+        Returns false if the node is now a different device or can't be
+        opened, the Joystick stays as it was then. */
+    bool reconnect();
+    virtual bool supportsReconnect() const { return true; }
+
+    /** Whether calibration and mapping are kept by the driver, where
+        every process opening the device sees them. Otherwise they only
+        live in this Joystick and get lost with it. */
+    virtual bool hasDriverCalibration() const { return true; }
+
     virtual std::string getFilename() const { return filename; }
     virtual QString getName() const { return name; }
     virtual int getAxisCount() const { return axis_count; }
@@ -72,8 +143,22 @@ public:
 
     virtual int getAxisState(int id);
 
+    /** drops stays 0 for LibinputJoystick, libinput resynchronizes on
+        its own and doesn't tell when it had to */
+    ReadStats getReadStats() const;
+    void resetReadStats();
+
     static std::vector<JoystickDescription> getJoysticks();
 
+    /** Query name, axis and button count of a joydev device without
+        setting up a Joystick for it. Only does plain syscalls, so it is
+        safe to call from any thread. Throws on error. */
+    static JoystickDescription probe(const std::string& filename);
+
+    /** Current CLOCK_MONOTONIC time in microseconds, the clock all event
+        timestamps are based on */
+    static uint64_t monotonicTime();
+
     virtual std::vector<CalibrationData> getCalibration();
     virtual void setCalibration(const std::vector<CalibrationData>& data);
     virtual void resetCalibration();
@@ -91,25 +176,92 @@ public:
     /** Corrects calibration data after remaping axes */
     virtual void correctCalibration(const std::vector<int>& mapping_old, const std::vector<int>& mapping_new);
 
-    /** Get the evdev that this joystick device is based on. This call
-        is just a guess, not guaranteed to be the exact same device, but
-        for our uses that should be enough. */
+    /** Get the evdev that this joystick device is based on, resolved
+        through sysfs so it is exact even for identical devices */
     virtual std::string getEvdev() const;
 
 signals:
-    void axisChanged(int number, int value);
-    void buttonChanged(int number, bool value);
+    /** time is the CLOCK_MONOTONIC timestamp of the event in microseconds */
+    void axisChanged(int number, int value, uint64_t time);
+    void buttonChanged(int number, bool value, uint64_t time);
+
+    /** Emitted once per drain of the device (or per SYN_REPORT for
+        evdev) with every axis and button that changed in between */
+    void frameReady(const JoystickFrame& frame);
 
 protected:
     // Protected constructor for derived classes
     Joystick();
-    
-private slots:
-    void onSocketActivated(int socket);
+
+    /** Applies a joydev style correction to a raw axis value, this is
+        the same fixed point math the kernel joydev driver uses */
+    static int correctValue(const struct js_corr& corr, int value);
+
+    /** Fetch up to max events from the device with a single read(),
+        returns 0 once the device is drained. This is called from the
+        reader thread when threaded reading is enabled, so it may only
+        touch fd, the stat counters and what decodeEvents() needs. */
+    virtual int readEvents(RawEvent* events, int max);
+
+    /** Size of one event in the wire format of the device */
+    virtual size_t getEventSize() const;
+
+    /** Decode count wire format events from data */
+    virtual void decodeEvents(const void* data, int count, RawEvent* events);
+
+    /** Decode and process a chunk of raw device data that was read by
+        someone else, e.g. io_uring, then flush the frame */
+    void processData(const char* data, size_t len);
+
+    /** Apply a single event to the state, always called on the thread
+        the Joystick lives in */
+    virtual void processEvent(const RawEvent& event);
+
+    /** Have the device read whenever fd becomes readable, through
+        JoystickUring when enabled, otherwise by calling update() from
+        the JoystickEventHub */
+    void startWatching();
+    void stopWatching();
+
+    /** Called after events got lost, either because the kernel sent
+        SYN_DROPPED or because the reader ring overflowed. Backends that
+        can query the device state should re-read all axes and buttons
+        and emit the difference as a single frame. joydev has no way to
+        do that, so the default does nothing. */
+    virtual void resynchronize(uint64_t time);
+
+    /** Open filename into fd for reconnect() and check that it is still
+        the same device by name, axis and button count, fd is -1 on
+        entry and the old fd is only closed when this succeeded. The
+        default is for joydev. */
+    virtual bool reopen();
+
+    /** Record a state change for the current frame, this also emits
+        the per event axisChanged()/buttonChanged() signals */
+    void frameAxis(int number, int value, uint64_t time);
+    void frameButton(int number, bool value, uint64_t time);
+
+    /** Emit frameReady() if anything changed since the last call */
+    void flushFrame();
+
+    /** Stop the reader thread for good and drop whatever it still has
+        queued, without emitting anything. For destructors, which must
+        not signal listeners about an object that is going away. */
+    void stopReader();
 
 private:
+    void onReaderActivated();
+
     Joystick(const Joystick&) = delete;
     Joystick& operator=(const Joystick&) = delete;
 };
 
+/** Conversion between CalibrationData and the joydev correction format */
+Joystick::CalibrationData corr2cal(const struct js_corr& corr);
+struct js_corr cal2corr(const Joystick::CalibrationData& data);
+
+/** Default calibration for an evdev axis, this gives the same
+    -32767..32767 scaling joydev applies */
+Joystick::CalibrationData absinfo2cal(const struct input_absinfo& absinfo);
+
 #endif // JSTEST_QT_JOYSTICK_H
@@ -0,0 +1,272 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "joystick_event_hub.h"
+
+#include <QDebug>
+#include <libinput.h>
+#include <libudev.h>
+#include <algorithm>
+#include <stdexcept>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+// Maximum number of ready fds fetched with one epoll_wait()
+static const int MAX_EPOLL_EVENTS = 64;
+
+static int hub_open_restricted(const char *path, int flags, void *user_data)
+{
+    int fd = open(path, flags);
+    return fd < 0 ? -errno : fd;
+}
+
+static void hub_close_restricted(int fd, void *user_data)
+{
+    close(fd);
+}
+
+static const struct libinput_interface hub_interface = {
+    .open_restricted = hub_open_restricted,
+    .close_restricted = hub_close_restricted,
+};
+
+// Singleton instance
+JoystickEventHub* JoystickEventHub::s_instance = nullptr;
+
+JoystickEventHub* JoystickEventHub::instance()
+{
+    if (!s_instance) {
+        s_instance = new JoystickEventHub;
+    }
+    return s_instance;
+}
+
+void JoystickEventHub::destroy()
+{
+    delete s_instance;
+    s_instance = nullptr;
+}
+
+JoystickEventHub::JoystickEventHub()
+    : m_epoll_fd(-1),
+      m_notifier(nullptr),
+      m_watches(),
+      m_dispatch_count(0),
+      m_udev(nullptr),
+      m_libinput(nullptr),
+      m_libinput_devices()
+{
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd < 0) {
+        throw std::runtime_error(std::string("JoystickEventHub: epoll_create1() failed: ") + strerror(errno));
+    }
+
+    m_notifier = new QSocketNotifier(m_epoll_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &JoystickEventHub::dispatch);
+    m_notifier->setEnabled(true);
+}
+
+JoystickEventHub::~JoystickEventHub()
+{
+    if (m_notifier) {
+        m_notifier->setEnabled(false);
+        delete m_notifier;
+        m_notifier = nullptr;
+    }
+
+    for (struct libinput_device* device : m_libinput_devices) {
+        libinput_path_remove_device(device);
+        libinput_device_unref(device);
+    }
+    m_libinput_devices.clear();
+
+    if (m_libinput) {
+        libinput_unref(m_libinput);
+        m_libinput = nullptr;
+    }
+
+    if (m_udev) {
+        udev_unref(m_udev);
+        m_udev = nullptr;
+    }
+
+    close(m_epoll_fd);
+}
+
+void JoystickEventHub::addWatch(int fd, Callback callback)
+{
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+
+    bool exists = m_watches.find(fd) != m_watches.end();
+    if (epoll_ctl(m_epoll_fd, exists ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) < 0) {
+        throw std::runtime_error(std::string("JoystickEventHub: epoll_ctl() failed: ") + strerror(errno));
+    }
+
+    m_watches[fd] = callback;
+}
+
+void JoystickEventHub::removeWatch(int fd)
+{
+    auto it = m_watches.find(fd);
+    if (it == m_watches.end())
+        return;
+
+    // Fails if fd is already closed, which also took it out of the set
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    m_watches.erase(it);
+}
+
+void JoystickEventHub::dispatch()
+{
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+    int count;
+
+    do {
+        count = epoll_wait(m_epoll_fd, events, MAX_EPOLL_EVENTS, 0);
+        if (count < 0) {
+            if (errno != EINTR) {
+                qWarning() << "JoystickEventHub: epoll_wait() failed:" << strerror(errno);
+            }
+            return;
+        }
+
+        if (count > 0) {
+            m_dispatch_count += 1;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+
+            // An earlier callback in this batch may have removed it
+            auto it = m_watches.find(fd);
+            if (it == m_watches.end())
+                continue;
+
+            // Copy, the callback is allowed to remove its own watch
+            Callback callback = it->second;
+            try {
+                callback();
+            } catch (const std::exception& err) {
+                qWarning() << "JoystickEventHub: removing watch on fd" << fd << ":" << err.what();
+                removeWatch(fd);
+            }
+        }
+    } while (count == MAX_EPOLL_EVENTS);
+}
+
+struct udev* JoystickEventHub::getUdev()
+{
+    if (!m_udev) {
+        m_udev = udev_new();
+        if (!m_udev) {
+            qWarning() << "Failed to initialize udev";
+        }
+    }
+    return m_udev;
+}
+
+bool JoystickEventHub::initLibinput()
+{
+    if (m_libinput)
+        return true;
+
+    m_libinput = libinput_path_create_context(&hub_interface, this);
+    if (!m_libinput) {
+        qWarning() << "Failed to create libinput context";
+        return false;
+    }
+
+    // Default priority, only errors get through
+    libinput_log_set_handler(m_libinput, [](struct libinput* /*li*/, enum libinput_log_priority priority,
+                                            const char* format, va_list args) {
+        char message[512];
+        vsnprintf(message, sizeof(message), format, args);
+
+        if (priority >= LIBINPUT_LOG_PRIORITY_ERROR) {
+            qWarning() << "libinput:" << QString::fromUtf8(message).trimmed();
+        } else {
+            qDebug() << "libinput:" << QString::fromUtf8(message).trimmed();
+        }
+    });
+
+    addWatch(libinput_get_fd(m_libinput), [this]() { dispatchLibinput(); });
+    return true;
+}
+
+struct libinput_device* JoystickEventHub::addLibinputDevice(const std::string& devnode, LibinputListener* listener)
+{
+    if (!initLibinput())
+        return nullptr;
+
+    struct libinput_device* device = libinput_path_add_device(m_libinput, devnode.c_str());
+    if (!device) {
+        return nullptr;
+    }
+
+    libinput_device_ref(device);
+    libinput_device_set_user_data(device, listener);
+    m_libinput_devices.push_back(device);
+
+    return device;
+}
+
+void JoystickEventHub::removeLibinputDevice(struct libinput_device* device)
+{
+    auto it = std::find(m_libinput_devices.begin(), m_libinput_devices.end(), device);
+    if (it == m_libinput_devices.end())
+        return;
+
+    m_libinput_devices.erase(it);
+
+    // Events still queued for the device must not reach the listener
+    libinput_device_set_user_data(device, nullptr);
+    libinput_path_remove_device(device);
+    libinput_device_unref(device);
+}
+
+void JoystickEventHub::dispatchLibinput()
+{
+    libinput_dispatch(m_libinput);
+
+    std::vector<LibinputListener*> touched;
+
+    struct libinput_event* event;
+    while ((event = libinput_get_event(m_libinput)) != nullptr) {
+        struct libinput_device* device = libinput_event_get_device(event);
+        LibinputListener* listener = static_cast<LibinputListener*>(libinput_device_get_user_data(device));
+        if (listener) {
+            listener->handleLibinputEvent(event);
+            if (std::find(touched.begin(), touched.end(), listener) == touched.end()) {
+                touched.push_back(listener);
+            }
+        }
+        libinput_event_destroy(event);
+    }
+
+    for (LibinputListener* listener : touched) {
+        listener->finishLibinputDispatch();
+    }
+}
@@ -0,0 +1,115 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_JOYSTICK_EVENT_HUB_H
+#define JSTEST_QT_JOYSTICK_EVENT_HUB_H
+
+#include <QObject>
+#include <QSocketNotifier>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+// Forward declarations to avoid including libinput headers in our header
+struct libinput;
+struct libinput_device;
+struct libinput_event;
+struct udev;
+
+/**
+ * Multiplexes the fds of all open devices over a single epoll instance,
+ * so Qt only has to watch one fd no matter how many devices are open.
+ * libinput devices share one path context that lives here as well.
+ */
+class JoystickEventHub : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<void()> Callback;
+
+    /** Receiver for events coming out of the shared libinput context */
+    class LibinputListener
+    {
+    public:
+        virtual ~LibinputListener() {}
+
+        virtual void handleLibinputEvent(struct libinput_event* event) = 0;
+
+        /** Called once per dispatch after all queued events went out */
+        virtual void finishLibinputDispatch() = 0;
+    };
+
+    // Singleton access
+    static JoystickEventHub* instance();
+
+    /** Tear the hub down while the QCoreApplication and its event
+        dispatcher still exist, everything watching fds through it has
+        to be gone by then */
+    static void destroy();
+
+    /** Call callback whenever fd becomes readable. The callback has to
+        drain the fd, it is level triggered. If it throws, the watch is
+        removed. */
+    void addWatch(int fd, Callback callback);
+    void removeWatch(int fd);
+
+    size_t getWatchCount() const { return m_watches.size(); }
+
+    /** Number of epoll_wait() calls that returned events */
+    uint64_t getDispatchCount() const { return m_dispatch_count; }
+
+    /** Shared udev context, created on first use */
+    struct udev* getUdev();
+
+    /** Add an evdev node to the shared libinput context. Returns nullptr
+        on failure. */
+    struct libinput_device* addLibinputDevice(const std::string& devnode, LibinputListener* listener);
+    void removeLibinputDevice(struct libinput_device* device);
+
+public slots:
+    /** Run all callbacks that are ready right now, this is what the Qt
+        event loop calls but it may also be called directly */
+    void dispatch();
+
+private:
+    static JoystickEventHub* s_instance;
+
+    JoystickEventHub();
+    ~JoystickEventHub();
+
+    bool initLibinput();
+    void dispatchLibinput();
+
+    int m_epoll_fd;
+    QSocketNotifier* m_notifier;
+    std::unordered_map<int, Callback> m_watches;
+    uint64_t m_dispatch_count;
+
+    struct udev* m_udev;
+    struct libinput* m_libinput;
+    std::vector<struct libinput_device*> m_libinput_devices;
+
+    // Prohibit copying
+    JoystickEventHub(const JoystickEventHub&) = delete;
+    JoystickEventHub& operator=(const JoystickEventHub&) = delete;
+};
+
+#endif // JSTEST_QT_JOYSTICK_EVENT_HUB_H
@@ -23,8 +23,10 @@
 #include <QProcessEnvironment>
 
 #include "joystick.h"
+#include "evdev_joystick.h"
 #include "libinput_joystick.h"
-#include "utils/libinput_helper.h"
+#include "utils/capability_cache.h"
+#include "utils/sysfs_topology.h"
 
 // Initialize static members
 JoystickBackend JoystickFactory::s_defaultBackend = JoystickBackend::AUTO;
@@ -71,11 +73,12 @@ JoystickBackend JoystickFactory::getDefaultBackend()
     return s_defaultBackend;
 }
 
-std::vector<JoystickDescription> JoystickFactory::getJoysticks(JoystickBackend backend)
+JoystickBackend JoystickFactory::resolveBackend(JoystickBackend backend)
 {
-    std::vector<JoystickDescription> result;
-    
-    // If AUTO, choose the best backend
+    // If AUTO, use the backend chosen on the command line or pick the best one
+    if (backend == JoystickBackend::AUTO) {
+        backend = s_defaultBackend;
+    }
     if (backend == JoystickBackend::AUTO) {
         if (isWaylandSession()) {
             backend = JoystickBackend::LIBINPUT;
@@ -83,75 +86,65 @@ std::vector<JoystickDescription> JoystickFactory::getJoysticks(JoystickBackend b
             backend = JoystickBackend::LEGACY;
         }
     }
+    return backend;
+}
+
+std::vector<JoystickDescription> JoystickFactory::getLibinputJoysticks()
+{
+    std::vector<JoystickDescription> result;
     
-    // Call the appropriate backend
-    switch (backend) {
-        case JoystickBackend::LIBINPUT: {
-            // Get devices using libinput
-            LibinputHelper* helper = LibinputHelper::instance();
-            if (helper->initialize()) {
-                QVector<LibinputHelper::DeviceInfo> devices = helper->findJoystickDevices();
-                for (const auto& device : devices) {
-                    JoystickDescription desc(
-                        device.sysPath.toStdString(),
-                        device.name.toStdString(),
-                        device.axisCount,
-                        device.buttonCount
-                    );
-                    result.push_back(desc);
-                }
-            }
-            
-            // If we didn't find any devices with libinput, fall back to legacy
-            if (result.empty()) {
-                qDebug() << "No devices found with libinput, falling back to legacy";
-                backend = JoystickBackend::LEGACY;
-            } else {
-                break;
-            }
+    // A libinput udev context would open every input device of the seat,
+    // LibinputJoystick only needs the syspath, so this goes by sysfs and
+    // the capability cache like JoystickProber::probeDevice() does for a
+    // single node
+    SysfsTopology topology;
+    CapabilityCache* cache = CapabilityCache::instance();
+    for (const SysfsTopology::InputDevice& device : topology.getDevices()) {
+        if (device.event.empty())
+            continue;
+        
+        CapabilityCache::Entry caps = cache->get(device);
+        if (caps.isJoystick()) {
+            result.push_back(JoystickDescription(device.syspath + "/" + device.event, device.name,
+                                                 caps.axis_count, caps.button_count));
         }
-            
-        case JoystickBackend::LEGACY:
-        default:
-            // Get devices using the traditional method
-            result = Joystick::getJoysticks();
-            break;
     }
+    cache->save();
     
     return result;
 }
 
 std::unique_ptr<Joystick> JoystickFactory::createJoystick(const std::string& device_path, JoystickBackend backend)
 {
-    // If AUTO, choose the best backend
-    if (backend == JoystickBackend::AUTO) {
-        if (isWaylandSession()) {
-            backend = JoystickBackend::LIBINPUT;
-        } else {
-            backend = JoystickBackend::LEGACY;
-        }
-    }
+    backend = resolveBackend(backend);
     
     // Create a joystick with the selected backend
     try {
         switch (backend) {
             case JoystickBackend::LIBINPUT:
                 try {
-                    // Try creating a LibinputJoystick
-                    // We need to cast it to Joystick* to make it compatible with the unique_ptr
-                    Joystick* joystick = new LibinputJoystick(device_path);
-                    return std::unique_ptr<Joystick>(joystick);
+                    return std::make_unique<LibinputJoystick>(device_path);
                 } catch (const std::exception& e) {
-                    // If libinput fails, fall back to legacy
                     qWarning() << "Failed to create LibinputJoystick, falling back to legacy:" << e.what();
-                    backend = JoystickBackend::LEGACY;
                 }
+                break;
+                
+            case JoystickBackend::EVDEV:
+                try {
+                    return std::make_unique<EvdevJoystick>(device_path);
+                } catch (const std::exception& e) {
+                    // Not an event device (e.g. a /dev/input/jsX path), use joydev instead
+                    qWarning() << "Failed to create EvdevJoystick, falling back to legacy:" << e.what();
+                }
+                break;
                 
             case JoystickBackend::LEGACY:
             default:
-                // Create a traditional joystick
-                return std::make_unique<Joystick>(device_path);
+                break;
         }
+        
+        // Create a traditional joystick, also where the others fall back to
+        return std::make_unique<Joystick>(device_path);
     } catch (const std::exception& e) {
         qWarning() << "Failed to create joystick:" << e.what();
         throw;
@@ -37,9 +37,6 @@ enum class JoystickBackend {
 
 class JoystickFactory {
 public:
-    // Get a list of available joysticks
-    static std::vector<JoystickDescription> getJoysticks(JoystickBackend backend = JoystickBackend::AUTO);
-    
     // Create a joystick instance
     static std::unique_ptr<Joystick> createJoystick(const std::string& device_path, JoystickBackend backend = JoystickBackend::AUTO);
     
@@ -52,6 +49,13 @@ public:
     // Get the current default backend
     static JoystickBackend getDefaultBackend();
     
+    // Turn AUTO into the backend that would actually be used
+    static JoystickBackend resolveBackend(JoystickBackend backend);
+    
+    // Devices for the libinput backend, without legacy fallback, only
+    // sysfs is read, nothing gets opened
+    static std::vector<JoystickDescription> getLibinputJoysticks();
+    
 private:
     static JoystickBackend s_defaultBackend;
 };
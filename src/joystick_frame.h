@@ -0,0 +1,87 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_JOYSTICK_FRAME_H
+#define JSTEST_QT_JOYSTICK_FRAME_H
+
+#include <QMetaType>
+#include <vector>
+#include <stdint.h>
+
+/** Complete axis and button state of a joystick together with a mask
+    of the entries that changed since the previous frame. time is the
+    CLOCK_MONOTONIC timestamp in microseconds of the newest event that
+    went into the frame. */
+class JoystickFrame
+{
+public:
+    std::vector<int> axes;
+    std::vector<bool> buttons;
+
+    std::vector<bool> axis_changed;
+    std::vector<bool> button_changed;
+    int change_count;
+    uint64_t time;
+
+    JoystickFrame()
+        : change_count(0),
+          time(0)
+    {}
+
+    void resize(int axis_count, int button_count)
+    {
+        axes.resize(axis_count, 0);
+        buttons.resize(button_count, false);
+        axis_changed.assign(axis_count, false);
+        button_changed.assign(button_count, false);
+        change_count = 0;
+    }
+
+    void setAxis(int number, int value)
+    {
+        axes[number] = value;
+        if (!axis_changed[number])
+        {
+            axis_changed[number] = true;
+            change_count += 1;
+        }
+    }
+
+    void setButton(int number, bool value)
+    {
+        buttons[number] = value;
+        if (!button_changed[number])
+        {
+            button_changed[number] = true;
+            change_count += 1;
+        }
+    }
+
+    bool isEmpty() const { return change_count == 0; }
+
+    void clearChanges()
+    {
+        axis_changed.assign(axis_changed.size(), false);
+        button_changed.assign(button_changed.size(), false);
+        change_count = 0;
+    }
+};
+
+Q_DECLARE_METATYPE(JoystickFrame)
+
+#endif // JSTEST_QT_JOYSTICK_FRAME_H
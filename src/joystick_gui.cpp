@@ -0,0 +1,88 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2009 Ingo Ruhnke <grumbel@gmail.com>
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "joystick_gui.h"
+
+#include "joystick.h"
+#include "dialogs/joystick_test_dialog.h"
+#include "dialogs/joystick_map_dialog.h"
+#include "dialogs/joystick_calibration_dialog.h"
+#include "utils/dialog_helper.h"
+
+JoystickGui::JoystickGui(std::unique_ptr<Joystick> joystick, bool simple_ui, QWidget* parent) :
+    QObject(nullptr),
+    m_joystick(std::move(joystick)),
+    m_test_dialog()
+{
+    // Create test dialog as a new top-level window
+    m_test_dialog = std::make_unique<JoystickTestDialog>(*this, *m_joystick, simple_ui);
+    
+    // Force dialog to be a separate window regardless of parent
+    m_test_dialog->setWindowFlags(Qt::Window);
+}
+
+JoystickGui::~JoystickGui()
+{
+}
+
+void
+JoystickGui::showCalibrationDialog()
+{
+    if (m_joystick->hasDriverCalibration())
+    {
+        // Instead of creating a dialog directly, launch it in a separate
+        // process, only joydev keeps its calibration in the driver
+        DialogManager::showCalibrationDialog(QString::fromStdString(m_joystick->getFilename()),
+                                             JoystickBackend::LEGACY);
+        return;
+    }
+
+    // The calibration only exists in m_joystick, a dialog in another
+    // process would calibrate a copy nobody reads
+    if (!m_calibration_dialog || !m_calibration_dialog->isVisible())
+    {
+        m_calibration_dialog = std::make_unique<JoystickCalibrationDialog>(*m_joystick);
+        m_calibration_dialog->setWindowFlags(Qt::Window);
+        m_calibration_dialog->show();
+    }
+    m_calibration_dialog->raise();
+    m_calibration_dialog->activateWindow();
+}
+
+void
+JoystickGui::showMappingDialog()
+{
+    if (m_joystick->hasDriverCalibration())
+    {
+        // Instead of creating a dialog directly, launch it in a separate process
+        DialogManager::showMappingDialog(QString::fromStdString(m_joystick->getFilename()),
+                                         JoystickBackend::LEGACY);
+        return;
+    }
+
+    // Same as for the calibration, the mapping lives in m_joystick
+    if (!m_mapping_dialog || !m_mapping_dialog->isVisible())
+    {
+        m_mapping_dialog = std::make_unique<JoystickMapDialog>(*m_joystick);
+        m_mapping_dialog->setWindowFlags(Qt::Window);
+        m_mapping_dialog->show();
+    }
+    m_mapping_dialog->raise();
+    m_mapping_dialog->activateWindow();
+}
@@ -0,0 +1,56 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2009 Ingo Ruhnke <grumbel@gmail.com>
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_JOYSTICK_GUI_H
+#define JSTEST_QT_JOYSTICK_GUI_H
+
+#include <QObject>
+#include <memory>
+
+class QWidget;
+class Joystick;
+class JoystickTestDialog;
+class JoystickMapDialog;
+class JoystickCalibrationDialog;
+
+class JoystickGui : public QObject
+{
+    Q_OBJECT
+
+private:
+    std::unique_ptr<Joystick> m_joystick;
+    std::unique_ptr<JoystickTestDialog> m_test_dialog;
+    std::unique_ptr<JoystickMapDialog> m_mapping_dialog;
+    std::unique_ptr<JoystickCalibrationDialog> m_calibration_dialog;
+
+public:
+    JoystickGui(std::unique_ptr<Joystick> joystick,
+                bool simple_ui,
+                QWidget* parent = nullptr);
+    ~JoystickGui() override;
+
+    JoystickTestDialog* getTestDialog() const { return m_test_dialog.get(); }
+    Joystick* getJoystick() const { return m_joystick.get(); }
+
+public slots:
+    void showCalibrationDialog();
+    void showMappingDialog();
+};
+
+#endif // JSTEST_QT_JOYSTICK_GUI_H
@@ -0,0 +1,104 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "joystick_monitor.h"
+
+#include <QDebug>
+#include <libudev.h>
+#include <string.h>
+
+#include "joystick_event_hub.h"
+
+JoystickMonitor* JoystickMonitor::s_instance = nullptr;
+
+JoystickMonitor* JoystickMonitor::instance()
+{
+    if (!s_instance) {
+        s_instance = new JoystickMonitor;
+    }
+    return s_instance;
+}
+
+void JoystickMonitor::destroy()
+{
+    delete s_instance;
+    s_instance = nullptr;
+}
+
+JoystickMonitor::JoystickMonitor()
+    : QObject(nullptr),
+      m_monitor(nullptr),
+      m_fd(-1)
+{
+    struct udev* udev = JoystickEventHub::instance()->getUdev();
+    if (!udev) {
+        qWarning() << "JoystickMonitor: no udev context, hotplug disabled";
+        return;
+    }
+
+    m_monitor = udev_monitor_new_from_netlink(udev, "udev");
+    if (!m_monitor) {
+        qWarning() << "JoystickMonitor: failed to create udev monitor, hotplug disabled";
+        return;
+    }
+
+    if (udev_monitor_filter_add_match_subsystem_devtype(m_monitor, "input", nullptr) < 0 ||
+        udev_monitor_enable_receiving(m_monitor) < 0)
+    {
+        qWarning() << "JoystickMonitor: failed to set up udev monitor, hotplug disabled";
+        udev_monitor_unref(m_monitor);
+        m_monitor = nullptr;
+        return;
+    }
+
+    m_fd = udev_monitor_get_fd(m_monitor);
+    JoystickEventHub::instance()->addWatch(m_fd, [this]() { onMonitorReadable(); });
+}
+
+JoystickMonitor::~JoystickMonitor()
+{
+    if (m_monitor) {
+        JoystickEventHub::instance()->removeWatch(m_fd);
+        udev_monitor_unref(m_monitor);
+    }
+}
+
+void JoystickMonitor::onMonitorReadable()
+{
+    // The monitor socket is non-blocking, drain it completely
+    while (struct udev_device* device = udev_monitor_receive_device(m_monitor)) {
+        const char* action  = udev_device_get_action(device);
+        const char* sysname = udev_device_get_sysname(device);
+        const char* devnode = udev_device_get_devnode(device);
+        const char* syspath = udev_device_get_syspath(device);
+
+        // The inputN parent devices come through as well, only the nodes
+        // are of interest
+        if (action && sysname && devnode && syspath &&
+            (strncmp(sysname, "js", 2) == 0 || strncmp(sysname, "event", 5) == 0))
+        {
+            if (strcmp(action, "add") == 0) {
+                emit deviceAdded(QString::fromUtf8(devnode), QString::fromUtf8(syspath));
+            } else if (strcmp(action, "remove") == 0) {
+                emit deviceRemoved(QString::fromUtf8(devnode), QString::fromUtf8(syspath));
+            }
+        }
+
+        udev_device_unref(device);
+    }
+}
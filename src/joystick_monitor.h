@@ -0,0 +1,71 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_JOYSTICK_MONITOR_H
+#define JSTEST_QT_JOYSTICK_MONITOR_H
+
+#include <QObject>
+#include <QString>
+
+// Forward declaration to avoid including libudev in our header
+struct udev_monitor;
+
+/**
+ * Reports js and event nodes coming and going, as seen by a udev
+ * monitor on the input subsystem. The monitor fd is watched through
+ * JoystickEventHub. Events are only reported after udev has processed
+ * its rules, so the node exists and has its final permissions.
+ */
+class JoystickMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Singleton access
+    static JoystickMonitor* instance();
+
+    /** Has to be called before JoystickEventHub::destroy() */
+    static void destroy();
+
+    /** False if the udev monitor couldn't be set up, no signals will
+        be emitted then */
+    bool isActive() const { return m_monitor != nullptr; }
+
+signals:
+    /** devnode is /dev/input/jsN or /dev/input/eventN, syspath the
+        matching /sys/devices/.../jsN or .../eventN */
+    void deviceAdded(const QString& devnode, const QString& syspath);
+    void deviceRemoved(const QString& devnode, const QString& syspath);
+
+private:
+    static JoystickMonitor* s_instance;
+
+    JoystickMonitor();
+    ~JoystickMonitor();
+
+    void onMonitorReadable();
+
+    struct udev_monitor* m_monitor;
+    int m_fd;
+
+    // Prohibit copying
+    JoystickMonitor(const JoystickMonitor&) = delete;
+    JoystickMonitor& operator=(const JoystickMonitor&) = delete;
+};
+
+#endif // JSTEST_QT_JOYSTICK_MONITOR_H
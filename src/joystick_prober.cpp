@@ -0,0 +1,302 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "joystick_prober.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QMetaObject>
+#include <QThreadPool>
+#include <stdexcept>
+
+#include "joystick.h"
+#include "evdev_joystick.h"
+#include "utils/capability_cache.h"
+#include "utils/sysfs_topology.h"
+
+// The pool is never destroyed on purpose: a probe stuck in the kernel
+// can't be interrupted, and destroying a QThreadPool waits for all of
+// its tasks, which would hang the application on exit
+static QThreadPool* probe_pool()
+{
+    static QThreadPool* pool = nullptr;
+    if (!pool) {
+        pool = new QThreadPool;
+        pool->setMaxThreadCount(JoystickProber::MAX_PARALLEL_PROBES);
+    }
+    return pool;
+}
+
+std::mutex JoystickProber::s_running_mutex;
+QHash<QString, JoystickProber::Running> JoystickProber::s_running;
+int JoystickProber::s_stuck_count = 0;
+
+JoystickProber::JoystickProber(QObject* parent)
+    : QObject(parent),
+      m_relay(std::make_shared<Relay>()),
+      m_next_token(0),
+      m_tokens(),
+      m_pending()
+{
+    m_relay->prober = this;
+}
+
+JoystickProber::~JoystickProber()
+{
+    // Tasks that are still running find nobody to report to
+    std::lock_guard<std::mutex> lock(m_relay->mutex);
+    m_relay->prober = nullptr;
+}
+
+void JoystickProber::start(JoystickBackend backend)
+{
+    m_tokens.clear();
+    qDeleteAll(m_pending);
+    m_pending.clear();
+
+    backend = JoystickFactory::resolveBackend(backend);
+
+    if (backend == JoystickBackend::LIBINPUT) {
+        std::vector<JoystickDescription> joysticks = JoystickFactory::getLibinputJoysticks();
+        if (!joysticks.empty()) {
+            for (const auto& joystick : joysticks) {
+                emit deviceFound(joystick);
+            }
+            emit finished();
+            return;
+        }
+
+        qDebug() << "No devices found with libinput, falling back to legacy";
+        backend = JoystickBackend::LEGACY;
+    }
+
+    if (backend == JoystickBackend::EVDEV) {
+        // Enumerated from sysfs, nothing gets opened
+        for (const auto& joystick : EvdevJoystick::getJoysticks()) {
+            emit deviceFound(joystick);
+        }
+        emit finished();
+        return;
+    }
+
+    // Legacy: the joydev nodes have to be opened to get their name
+    QDir devDir("/dev/input");
+    QStringList nodes;
+    for (int i = 0; i < 32; ++i) {
+        QString joystickPath = QString("js%1").arg(i);
+        if (devDir.exists(joystickPath)) {
+            nodes << devDir.filePath(joystickPath);
+        }
+    }
+
+    if (nodes.isEmpty()) {
+        // Joystick::getJoysticks() falls back to sysfs in this case,
+        // which doesn't open anything either
+        for (const auto& joystick : Joystick::getJoysticks()) {
+            emit deviceFound(joystick);
+        }
+        emit finished();
+        return;
+    }
+
+    for (const QString& node : nodes) {
+        emit deviceQueued(node);
+        probeAsync(node);
+    }
+}
+
+void JoystickProber::probeDevice(const QString& devnode, const QString& syspath,
+                                 JoystickBackend backend)
+{
+    backend = JoystickFactory::resolveBackend(backend);
+    bool is_js = devnode.startsWith("/dev/input/js");
+
+    if (is_js) {
+        if (backend == JoystickBackend::LEGACY) {
+            emit deviceQueued(devnode);
+            probeAsync(devnode);
+        }
+        return;
+    }
+
+    // An event node, its capabilities are in the input device above it
+    SysfsTopology::InputDevice device;
+    if (!SysfsTopology::readDevice(syspath.left(syspath.lastIndexOf('/')).toStdString(), device))
+        return;
+
+    CapabilityCache::Entry caps = CapabilityCache::instance()->get(device);
+    CapabilityCache::instance()->save();
+    if (!caps.isJoystick())
+        return;
+
+    QString filename;
+    switch (backend) {
+        case JoystickBackend::LIBINPUT:
+            // The libinput backend identifies devices by their syspath
+            filename = syspath;
+            break;
+
+        case JoystickBackend::EVDEV:
+            filename = devnode;
+            break;
+
+        case JoystickBackend::LEGACY:
+        default:
+            // Only listed when joydev doesn't provide a node for it, the
+            // js node shows up on its own otherwise
+            if (!device.js.empty())
+                return;
+            filename = devnode;
+            break;
+    }
+
+    emit deviceFound(JoystickDescription(filename.toStdString(), device.name,
+                                         caps.axis_count, caps.button_count));
+}
+
+void JoystickProber::cancel(const QString& filename)
+{
+    m_tokens.remove(filename);
+
+    QTimer* timer = m_pending.take(filename);
+    if (timer) {
+        delete timer;
+        checkFinished();
+    }
+}
+
+void JoystickProber::probeAsync(const QString& filename)
+{
+    // A probe of the same node that is still running is superseded
+    delete m_pending.take(filename);
+
+    QTimer* timer = new QTimer(this);
+    timer->setSingleShot(true);
+    connect(timer, &QTimer::timeout, this, [this, filename]() { onProbeTimeout(filename); });
+    timer->start(PROBE_TIMEOUT_MS);
+    m_pending.insert(filename, timer);
+
+    unsigned token = ++m_next_token;
+    m_tokens.insert(filename, token);
+
+    {
+        std::lock_guard<std::mutex> lock(s_running_mutex);
+        auto it = s_running.find(filename);
+        if (it != s_running.end()) {
+            // Another worker would only get stuck behind the first one,
+            // so that one answers this probe instead
+            it->relay = m_relay;
+            it->token = token;
+            return;
+        }
+        s_running.insert(filename, Running{ m_relay, token, false });
+    }
+
+    probe_pool()->start([filename]() {
+        bool ok = false;
+        JoystickDescription description(filename.toStdString(), std::string(), 0, 0);
+        QString error;
+
+        try {
+            description = Joystick::probe(filename.toStdString());
+            ok = true;
+        } catch (const std::exception& err) {
+            error = QString::fromLocal8Bit(err.what());
+        }
+
+        // Whoever probed the node last gets the answer
+        std::shared_ptr<Relay> relay;
+        unsigned token;
+        {
+            std::lock_guard<std::mutex> lock(s_running_mutex);
+            Running running = s_running.take(filename);
+            relay = running.relay;
+            token = running.token;
+            if (running.stuck) {
+                s_stuck_count -= 1;
+                probe_pool()->setMaxThreadCount(MAX_PARALLEL_PROBES + s_stuck_count);
+            }
+        }
+
+        // Posting an event is fine from any thread, as long as the
+        // receiver can't go away while we do it
+        std::lock_guard<std::mutex> lock(relay->mutex);
+        if (relay->prober) {
+            JoystickProber* prober = relay->prober;
+            QMetaObject::invokeMethod(prober, [=]() {
+                prober->onProbeFinished(token, filename, ok, description, error);
+            }, Qt::QueuedConnection);
+        }
+    });
+}
+
+void JoystickProber::onProbeFinished(unsigned token, const QString& filename,
+                                     bool ok, const JoystickDescription& description, const QString& error)
+{
+    if (m_tokens.value(filename, 0) != token)
+        return;
+
+    m_tokens.remove(filename);
+
+    QTimer* timer = m_pending.take(filename);
+    delete timer;
+
+    if (ok) {
+        emit deviceFound(description);
+    } else {
+        emit deviceFailed(filename, error);
+    }
+
+    // A late answer after the timeout already counted as finished
+    if (timer) {
+        checkFinished();
+    }
+}
+
+void JoystickProber::onProbeTimeout(const QString& filename)
+{
+    QTimer* timer = m_pending.take(filename);
+    if (!timer)
+        return;
+
+    timer->deleteLater();
+
+    // The worker keeps its thread until the kernel lets go, the others
+    // shouldn't have to wait for that
+    {
+        std::lock_guard<std::mutex> lock(s_running_mutex);
+        auto it = s_running.find(filename);
+        if (it != s_running.end() && !it->stuck) {
+            it->stuck = true;
+            s_stuck_count += 1;
+            probe_pool()->setMaxThreadCount(MAX_PARALLEL_PROBES + s_stuck_count);
+        }
+    }
+
+    qWarning() << "JoystickProber:" << filename << "did not answer within" << PROBE_TIMEOUT_MS << "ms";
+    emit deviceTimedOut(filename);
+
+    checkFinished();
+}
+
+void JoystickProber::checkFinished()
+{
+    if (m_pending.isEmpty()) {
+        emit finished();
+    }
+}
@@ -0,0 +1,131 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_JOYSTICK_PROBER_H
+#define JSTEST_QT_JOYSTICK_PROBER_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QTimer>
+#include <memory>
+#include <mutex>
+
+#include "joystick_description.h"
+#include "joystick_factory.h"
+
+/**
+ * Enumerates joysticks without blocking the GUI thread. Device nodes
+ * that have to be opened are probed on a small worker pool, each with
+ * its own deadline, and the results are reported one by one as they
+ * come in, so a device that hangs in the kernel only delays itself.
+ * A node is never probed twice at the same time, a new probe of a node
+ * whose worker is still stuck waits for that worker's answer, and the
+ * pool grows by one thread for every worker that is past its deadline.
+ * The evdev and libinput backends enumerate through sysfs, they don't
+ * open anything and report their devices right away.
+ */
+class JoystickProber : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** Time a single device gets before it is reported as timed out */
+    static const int PROBE_TIMEOUT_MS = 2000;
+
+    /** Number of devices probed at the same time, not counting the ones
+        that timed out and still hold a thread */
+    static const int MAX_PARALLEL_PROBES = 4;
+
+    JoystickProber(QObject* parent = nullptr);
+    ~JoystickProber() override;
+
+    /** Start a new enumeration, results of a previous one that are
+        still outstanding are dropped */
+    void start(JoystickBackend backend = JoystickBackend::AUTO);
+
+    /** Look at a single node that just appeared, devnode and syspath as
+        reported by JoystickMonitor. Nodes that don't belong to the
+        backend are ignored. */
+    void probeDevice(const QString& devnode, const QString& syspath,
+                     JoystickBackend backend = JoystickBackend::AUTO);
+
+    /** Drop an outstanding probe, e.g. because the device went away */
+    void cancel(const QString& filename);
+
+    bool isRunning() const { return !m_pending.isEmpty(); }
+
+signals:
+    /** A device node was found and is being probed */
+    void deviceQueued(const QString& filename);
+
+    /** A device was probed successfully, may come after deviceTimedOut()
+        when a slow device answers late */
+    void deviceFound(const JoystickDescription& description);
+
+    /** Probing failed, the node is not a usable joystick */
+    void deviceFailed(const QString& filename, const QString& error);
+
+    /** The device didn't answer within PROBE_TIMEOUT_MS */
+    void deviceTimedOut(const QString& filename);
+
+    /** Every device has either answered or timed out */
+    void finished();
+
+private:
+    // Shared with the worker tasks, which may outlive us when a device
+    // never answers
+    struct Relay {
+        std::mutex mutex;
+        JoystickProber* prober;
+    };
+
+    // A worker of the pool, by node. Shared by all probers, the worker
+    // reports to whoever probed the node last.
+    struct Running {
+        std::shared_ptr<Relay> relay;
+        unsigned token;
+        bool stuck;     // past its deadline, counted in s_stuck_count
+    };
+
+    static std::mutex s_running_mutex;
+    static QHash<QString, Running> s_running;
+    static int s_stuck_count;
+
+    void probeAsync(const QString& filename);
+    void onProbeFinished(unsigned token, const QString& filename,
+                         bool ok, const JoystickDescription& description, const QString& error);
+    void onProbeTimeout(const QString& filename);
+    void checkFinished();
+
+    std::shared_ptr<Relay> m_relay;
+
+    // Every probe gets a token, answers are only accepted for the
+    // latest probe of a node
+    unsigned m_next_token;
+    QHash<QString, unsigned> m_tokens;
+
+    // Probes that haven't answered or timed out yet
+    QHash<QString, QTimer*> m_pending;
+
+    // Prohibit copying
+    JoystickProber(const JoystickProber&) = delete;
+    JoystickProber& operator=(const JoystickProber&) = delete;
+};
+
+#endif // JSTEST_QT_JOYSTICK_PROBER_H
@@ -0,0 +1,176 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "joystick_reader.h"
+
+#include <QDebug>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <stdexcept>
+
+JoystickReader::JoystickReader(int fd, ReadFunction read_events)
+    : m_fd(fd),
+      m_read_events(read_events),
+      m_ring(),
+      m_wake_fd(-1),
+      m_stop_fd(-1),
+      m_wake_pending(false),
+      m_failed(false),
+      m_overflows(0),
+      m_thread()
+{
+    m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wake_fd < 0 || m_stop_fd < 0)
+    {
+        std::string error = strerror(errno);
+        if (m_wake_fd >= 0) close(m_wake_fd);
+        if (m_stop_fd >= 0) close(m_stop_fd);
+        throw std::runtime_error("JoystickReader: eventfd() failed: " + error);
+    }
+}
+
+JoystickReader::~JoystickReader()
+{
+    stop();
+    close(m_wake_fd);
+    close(m_stop_fd);
+}
+
+void
+JoystickReader::start()
+{
+    if (!m_thread.joinable())
+    {
+        m_thread = std::thread(&JoystickReader::run, this);
+    }
+}
+
+void
+JoystickReader::stop()
+{
+    if (m_thread.joinable())
+    {
+        uint64_t one = 1;
+        if (write(m_stop_fd, &one, sizeof(one)) < 0)
+        {
+            qWarning() << "JoystickReader: failed to signal reader thread:" << strerror(errno);
+        }
+        m_thread.join();
+
+        // Leave the stop fd unsignaled so the reader can be restarted
+        uint64_t counter;
+        while (read(m_stop_fd, &counter, sizeof(counter)) > 0) {}
+    }
+}
+
+void
+JoystickReader::acknowledge()
+{
+    uint64_t counter;
+    while (read(m_wake_fd, &counter, sizeof(counter)) > 0) {}
+
+    // Clear before draining, anything pushed from now on triggers a new wakeup
+    m_wake_pending.store(false);
+}
+
+void
+JoystickReader::wakeConsumer()
+{
+    // Only one eventfd write per drain of the consumer, not one per batch
+    if (!m_wake_pending.exchange(true))
+    {
+        uint64_t one = 1;
+        if (write(m_wake_fd, &one, sizeof(one)) < 0)
+        {
+            qWarning() << "JoystickReader: failed to wake consumer:" << strerror(errno);
+        }
+    }
+}
+
+void
+JoystickReader::run()
+{
+    struct pollfd fds[2];
+    fds[0].fd = m_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = m_stop_fd;
+    fds[1].events = POLLIN;
+
+    Joystick::RawEvent events[Joystick::EVENT_BATCH_SIZE];
+
+    while (true)
+    {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            qWarning() << "JoystickReader: poll() failed:" << strerror(errno);
+            m_failed.store(true);
+            break;
+        }
+
+        if (fds[1].revents)
+            break;
+
+        if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+        {
+            qWarning() << "JoystickReader: device went away";
+            m_failed.store(true);
+            break;
+        }
+
+        try
+        {
+            int count;
+            do
+            {
+                count = m_read_events(events, Joystick::EVENT_BATCH_SIZE);
+                for (int i = 0; i < count; ++i)
+                {
+                    if (!m_ring.push(events[i]))
+                    {
+                        m_overflows.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+            while (count == Joystick::EVENT_BATCH_SIZE);
+        }
+        catch (const std::exception& err)
+        {
+            qWarning() << "JoystickReader:" << err.what();
+            m_failed.store(true);
+            break;
+        }
+
+        if (m_ring.size() > 0)
+        {
+            wakeConsumer();
+        }
+    }
+
+    // Let the consumer notice the failure
+    wakeConsumer();
+}
@@ -0,0 +1,86 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_JOYSTICK_READER_H
+#define JSTEST_QT_JOYSTICK_READER_H
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <stdint.h>
+
+#include "joystick.h"
+#include "utils/spsc_ring.h"
+
+/**
+ * Reads a device on its own thread so that slow painting or a modal
+ * dialog on the GUI thread can't stall the kernel queue. Events are
+ * handed over through a lock-free ring, the consumer gets woken up
+ * through an eventfd that can be watched with a QSocketNotifier.
+ */
+class JoystickReader
+{
+public:
+    typedef std::function<int (Joystick::RawEvent* events, int max)> ReadFunction;
+
+private:
+    int m_fd;
+    ReadFunction m_read_events;
+
+    SpscRing<Joystick::RawEvent, 4096> m_ring;
+
+    int m_wake_fd;  // reader -> consumer, readable when events are queued
+    int m_stop_fd;  // consumer -> reader, asks the thread to exit
+
+    std::atomic<bool> m_wake_pending;
+    std::atomic<bool> m_failed;
+    std::atomic<uint64_t> m_overflows;
+
+    std::thread m_thread;
+
+public:
+    /** read_events is called on the reader thread whenever fd becomes
+        readable, it must only touch the fd and thread-safe state */
+    JoystickReader(int fd, ReadFunction read_events);
+    ~JoystickReader();
+
+    void start();
+    void stop();
+
+    /** File descriptor the consumer should watch for readability */
+    int getWakeFd() const { return m_wake_fd; }
+
+    /** Consumer side: call once per wakeup before draining with pop() */
+    void acknowledge();
+    bool pop(Joystick::RawEvent& event) { return m_ring.pop(event); }
+
+    /** Number of events dropped because the ring was full */
+    uint64_t getOverflowCount() const { return m_overflows.load(std::memory_order_relaxed); }
+
+    /** True once reading failed, e.g. because the device was unplugged */
+    bool hasFailed() const { return m_failed.load(); }
+
+private:
+    void run();
+    void wakeConsumer();
+
+    JoystickReader(const JoystickReader&) = delete;
+    JoystickReader& operator=(const JoystickReader&) = delete;
+};
+
+#endif // JSTEST_QT_JOYSTICK_READER_H
@@ -0,0 +1,382 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "joystick_uring.h"
+
+#include <QDebug>
+#include <liburing.h>
+#include <algorithm>
+#include <stdexcept>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+
+#include "joystick_event_hub.h"
+
+// Cancel requests and polls carry the slot index with one of these bits
+// set, so their completions can be told apart from the reads
+static const uint64_t CANCEL_TAG = 1ULL << 63;
+static const uint64_t POLL_TAG = 1ULL << 62;
+
+// Number of completions fetched from the ring at once
+static const unsigned CQE_BATCH_SIZE = 64;
+
+bool JoystickUring::s_enabled = false;
+bool JoystickUring::s_initialized = false;
+JoystickUring* JoystickUring::s_instance = nullptr;
+
+void JoystickUring::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+JoystickUring* JoystickUring::instance()
+{
+    if (!s_enabled)
+        return nullptr;
+
+    if (!s_initialized) {
+        s_initialized = true;
+        try {
+            s_instance = new JoystickUring;
+        } catch (const std::exception& err) {
+            qWarning() << "io_uring not available, falling back to read():" << err.what();
+        }
+    }
+
+    return s_instance;
+}
+
+void JoystickUring::destroy()
+{
+    delete s_instance;
+    s_instance = nullptr;
+}
+
+JoystickUring::JoystickUring()
+    : m_ring(new struct io_uring),
+      m_event_fd(-1),
+      m_buffers(BUFFER_SIZE * MAX_SLOTS),
+      m_slots(MAX_SLOTS),
+      m_fd_to_slot(),
+      m_pending_sqes(0),
+      m_submit_count(0)
+{
+    // Room for a poll and a read per slot and a cancel for each of them
+    int ret = io_uring_queue_init(MAX_SLOTS * 4, m_ring.get(), 0);
+    if (ret < 0) {
+        throw std::runtime_error(std::string("io_uring_queue_init() failed: ") + strerror(-ret));
+    }
+
+    std::vector<struct iovec> iovecs(MAX_SLOTS);
+    for (size_t i = 0; i < MAX_SLOTS; ++i) {
+        iovecs[i].iov_base = m_buffers.data() + i * BUFFER_SIZE;
+        iovecs[i].iov_len  = BUFFER_SIZE;
+        m_slots[i] = Slot{ -1, 0, Callback(), false, false, false, false };
+    }
+
+    ret = io_uring_register_buffers(m_ring.get(), iovecs.data(), iovecs.size());
+    if (ret < 0) {
+        io_uring_queue_exit(m_ring.get());
+        throw std::runtime_error(std::string("io_uring_register_buffers() failed: ") + strerror(-ret));
+    }
+
+    m_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_event_fd < 0) {
+        std::string error = strerror(errno);
+        io_uring_queue_exit(m_ring.get());
+        throw std::runtime_error("eventfd() failed: " + error);
+    }
+
+    ret = io_uring_register_eventfd(m_ring.get(), m_event_fd);
+    if (ret < 0) {
+        close(m_event_fd);
+        io_uring_queue_exit(m_ring.get());
+        throw std::runtime_error(std::string("io_uring_register_eventfd() failed: ") + strerror(-ret));
+    }
+
+    JoystickEventHub::instance()->addWatch(m_event_fd, [this]() { processCompletions(); });
+}
+
+JoystickUring::~JoystickUring()
+{
+    JoystickEventHub::instance()->removeWatch(m_event_fd);
+
+    // Tearing down the ring cancels whatever is still in flight
+    io_uring_queue_exit(m_ring.get());
+    close(m_event_fd);
+}
+
+bool JoystickUring::addRead(int fd, size_t len, Callback callback)
+{
+    if (m_fd_to_slot.find(fd) != m_fd_to_slot.end()) {
+        removeRead(fd);
+    }
+
+    // A slot whose cancel hasn't completed yet still owns its buffer
+    auto it = std::find_if(m_slots.begin(), m_slots.end(), [](const Slot& slot) {
+        return !slot.active && !slot.poll_armed && !slot.read_in_flight;
+    });
+    if (it == m_slots.end()) {
+        return false;
+    }
+
+    size_t index = it - m_slots.begin();
+    Slot& slot = *it;
+    slot.fd = fd;
+    slot.len = std::min(len, BUFFER_SIZE);
+    slot.callback = callback;
+    slot.active = true;
+    slot.read_again = false;
+    m_fd_to_slot[fd] = index;
+
+    armPoll(index);
+    submit();
+    return true;
+}
+
+void JoystickUring::removeRead(int fd)
+{
+    auto it = m_fd_to_slot.find(fd);
+    if (it == m_fd_to_slot.end())
+        return;
+
+    size_t index = it->second;
+    m_fd_to_slot.erase(it);
+
+    Slot& slot = m_slots[index];
+    slot.active = false;
+    slot.read_again = false;
+    slot.callback = Callback();
+
+    if (slot.poll_armed) {
+        if (struct io_uring_sqe* sqe = getSqe()) {
+            io_uring_prep_poll_remove(sqe, index | POLL_TAG);
+            io_uring_sqe_set_data64(sqe, index | CANCEL_TAG);
+            m_pending_sqes += 1;
+        }
+    }
+
+    if (slot.read_in_flight) {
+        if (struct io_uring_sqe* sqe = getSqe()) {
+            io_uring_prep_cancel64(sqe, index, 0);
+            io_uring_sqe_set_data64(sqe, index | CANCEL_TAG);
+            m_pending_sqes += 1;
+        }
+    }
+
+    submit();
+}
+
+struct io_uring_sqe* JoystickUring::getSqe()
+{
+    struct io_uring_sqe* sqe = io_uring_get_sqe(m_ring.get());
+    if (!sqe) {
+        submit();
+        sqe = io_uring_get_sqe(m_ring.get());
+    }
+    return sqe;
+}
+
+void JoystickUring::armPoll(size_t index)
+{
+    Slot& slot = m_slots[index];
+
+    struct io_uring_sqe* sqe = getSqe();
+    if (!sqe) {
+        qWarning() << "JoystickUring: submission queue full, dropping fd" << slot.fd;
+        return;
+    }
+
+    // Stays armed and completes every time the fd becomes readable
+    io_uring_prep_poll_multishot(sqe, slot.fd, POLLIN);
+    io_uring_sqe_set_data64(sqe, index | POLL_TAG);
+    slot.poll_armed = true;
+    m_pending_sqes += 1;
+}
+
+void JoystickUring::queueRead(size_t index)
+{
+    Slot& slot = m_slots[index];
+
+    // One read per slot at a time, it owns the buffer
+    if (slot.read_in_flight) {
+        slot.read_again = true;
+        return;
+    }
+
+    struct io_uring_sqe* sqe = getSqe();
+    if (!sqe) {
+        qWarning() << "JoystickUring: submission queue full, dropping fd" << slot.fd;
+        return;
+    }
+
+    // Offset -1 reads from the current position, devices don't seek
+    io_uring_prep_read_fixed(sqe, slot.fd, m_buffers.data() + index * BUFFER_SIZE,
+                             slot.len, static_cast<uint64_t>(-1), index);
+    io_uring_sqe_set_data64(sqe, index);
+    slot.read_in_flight = true;
+    m_pending_sqes += 1;
+}
+
+void JoystickUring::submit()
+{
+    if (m_pending_sqes == 0)
+        return;
+
+    int ret = io_uring_submit(m_ring.get());
+    m_submit_count += 1;
+    if (ret < 0) {
+        qWarning() << "JoystickUring: io_uring_submit() failed:" << strerror(-ret);
+        return;
+    }
+    m_pending_sqes = 0;
+}
+
+void JoystickUring::processCompletions()
+{
+    uint64_t counter;
+    while (read(m_event_fd, &counter, sizeof(counter)) > 0) {}
+
+    struct io_uring_cqe* cqes[CQE_BATCH_SIZE];
+    uint64_t user_data[CQE_BATCH_SIZE];
+    int results[CQE_BATCH_SIZE];
+    unsigned flags[CQE_BATCH_SIZE];
+    unsigned count;
+
+    do {
+        count = io_uring_peek_batch_cqe(m_ring.get(), cqes, CQE_BATCH_SIZE);
+
+        // Copy out and release the entries first, the callbacks may add
+        // and remove reads
+        for (unsigned i = 0; i < count; ++i) {
+            user_data[i] = io_uring_cqe_get_data64(cqes[i]);
+            results[i] = cqes[i]->res;
+            flags[i] = cqes[i]->flags;
+        }
+        io_uring_cq_advance(m_ring.get(), count);
+
+        for (unsigned i = 0; i < count; ++i) {
+            if (user_data[i] & CANCEL_TAG)
+                continue;
+
+            size_t index = user_data[i] & ~POLL_TAG;
+            if (index >= m_slots.size())
+                continue;
+
+            if (user_data[i] & POLL_TAG) {
+                handlePoll(index, results[i], flags[i] & IORING_CQE_F_MORE);
+            } else {
+                handleRead(index, results[i]);
+            }
+        }
+    } while (count == CQE_BATCH_SIZE);
+
+    // Everything that got queued goes out in one go
+    submit();
+}
+
+void JoystickUring::handlePoll(size_t index, int result, bool more)
+{
+    Slot& slot = m_slots[index];
+    slot.poll_armed = more;
+
+    // Final completion of a poll that was removed
+    if (!slot.active)
+        return;
+
+    if (result < 0) {
+        reportError(index, result);
+        return;
+    }
+
+    // POLLERR and POLLHUP go through the read too, which returns the
+    // actual error
+    queueRead(index);
+
+    // The kernel ends a multishot poll e.g. when the completion queue
+    // overflowed
+    if (!slot.poll_armed) {
+        armPoll(index);
+    }
+}
+
+void JoystickUring::handleRead(size_t index, int result)
+{
+    Slot& slot = m_slots[index];
+    bool read_again = slot.read_again;
+    slot.read_in_flight = false;
+    slot.read_again = false;
+
+    // Completion of a read that was removed
+    if (!slot.active)
+        return;
+
+    if (result == -EAGAIN || result == -EINTR) {
+        // Nothing there after all, the poll reports when there is. Never
+        // re-arm blindly here, the fd is O_NONBLOCK and that would spin.
+        if (read_again) {
+            queueRead(index);
+        }
+        return;
+    }
+
+    if (result <= 0) {
+        // 0 is end of file, which a device never sends while present
+        reportError(index, result == 0 ? -ENODEV : result);
+        return;
+    }
+
+    int fd = slot.fd;
+    Callback callback = slot.callback;
+
+    try {
+        callback(m_buffers.data() + index * BUFFER_SIZE, result);
+    } catch (const std::exception& err) {
+        qWarning() << "JoystickUring: removing fd" << fd << ":" << err.what();
+        removeRead(fd);
+        return;
+    }
+
+    // A full buffer may have left events behind that the poll won't
+    // report again. The callback may have removed or replaced the read.
+    if (slot.active && slot.fd == fd &&
+        (read_again || result == static_cast<int>(slot.len))) {
+        queueRead(index);
+    }
+}
+
+void JoystickUring::reportError(size_t index, int error)
+{
+    Slot& slot = m_slots[index];
+    int fd = slot.fd;
+    Callback callback = slot.callback;
+
+    try {
+        callback(nullptr, error);
+    } catch (const std::exception& err) {
+        qWarning() << "JoystickUring: removing fd" << fd << ":" << err.what();
+    }
+
+    if (slot.active && slot.fd == fd) {
+        removeRead(fd);
+    }
+}
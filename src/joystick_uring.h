@@ -0,0 +1,117 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_JOYSTICK_URING_H
+#define JSTEST_QT_JOYSTICK_URING_H
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+// Forward declaration to avoid including liburing in our header
+struct io_uring;
+
+/**
+ * Watches every registered fd with a multishot poll through io_uring
+ * and reads it into its own registered buffer once it becomes readable.
+ * Device fds are O_NONBLOCK, so a read that is simply kept armed would
+ * complete with -EAGAIN right away, the poll is what waits for data.
+ * Completions are signaled through an eventfd that is watched by
+ * JoystickEventHub and all reads go out with a single io_uring_submit(),
+ * so draining any number of devices costs a constant number of syscalls.
+ *
+ * Only available when built with USE_LIBURING.
+ */
+class JoystickUring
+{
+public:
+    /** Called with the data of a completed read, or with nullptr and a
+        negative errno. If it throws, the fd is removed. */
+    typedef std::function<void(const char* data, int result)> Callback;
+
+    /** Size of the registered buffer of each fd */
+    static const size_t BUFFER_SIZE = 1536;
+
+    /** Maximum number of fds that can be registered at the same time */
+    static const size_t MAX_SLOTS = 256;
+
+    /** Has to be called before the first instance() call */
+    static void setEnabled(bool enabled);
+
+    /** Returns nullptr when not enabled or when io_uring isn't usable,
+        callers should fall back to read() then */
+    static JoystickUring* instance();
+
+    /** Has to be called before JoystickEventHub::destroy(), instance()
+        returns nullptr afterwards */
+    static void destroy();
+
+    /** Read up to len bytes from fd whenever it becomes readable, len
+        should be a multiple of the event size. Returns false if no slot
+        is free. */
+    bool addRead(int fd, size_t len, Callback callback);
+    void removeRead(int fd);
+
+    /** Number of io_uring_submit() calls so far */
+    uint64_t getSubmitCount() const { return m_submit_count; }
+
+    ~JoystickUring();
+
+private:
+    struct Slot {
+        int fd;
+        size_t len;
+        Callback callback;
+        bool active;
+        bool poll_armed;     // multishot poll still delivers completions
+        bool read_in_flight;
+        bool read_again;     // became readable while the read was in flight
+    };
+
+    JoystickUring();
+
+    struct io_uring_sqe* getSqe();
+    void armPoll(size_t index);
+    void queueRead(size_t index);
+    void submit();
+    void processCompletions();
+    void handlePoll(size_t index, int result, bool more);
+    void handleRead(size_t index, int result);
+    void reportError(size_t index, int error);
+
+    static bool s_enabled;
+    static bool s_initialized;
+    static JoystickUring* s_instance;
+
+    std::unique_ptr<struct io_uring> m_ring;
+    int m_event_fd;
+    std::vector<char> m_buffers;
+    std::vector<Slot> m_slots;
+    std::unordered_map<int, size_t> m_fd_to_slot;
+    unsigned m_pending_sqes;
+    uint64_t m_submit_count;
+
+    // Prohibit copying
+    JoystickUring(const JoystickUring&) = delete;
+    JoystickUring& operator=(const JoystickUring&) = delete;
+};
+
+#endif // JSTEST_QT_JOYSTICK_URING_H
@@ -25,72 +25,46 @@
 #include <vector>
 #include <memory>
 
-#include "joystick.h" // Include the base class header
+#include "evdev_joystick.h"
+#include "joystick_event_hub.h"
 
 // Forward declarations
-struct libinput;
 struct libinput_device;
-struct udev;
-
-// Inherit from Joystick class
-class LibinputJoystick : public Joystick
+struct libinput_event;
+
+// Events come from the libinput context shared by all devices in
+// JoystickEventHub and go through the same numbering, lookup tables and
+// calibration as EvdevJoystick. The evdev node is only opened once to
+// read the capabilities, so axes libinput doesn't report never change.
+class LibinputJoystick : public EvdevJoystick,
+                         private JoystickEventHub::LibinputListener
 {
     Q_OBJECT
 
 private:
-    // Private device-specific context
-    struct udev* m_udev;
-    struct libinput* m_libinput;
     libinput_device* m_device;
-    QSocketNotifier* m_notifier;
     
     std::string m_syspath;
-    std::vector<bool> m_button_state;
-    std::vector<int> m_axis_mapping;
-    std::vector<int> m_button_mapping;
 
 public:
     // Constructor takes a device path
     LibinputJoystick(const std::string& device_path);
     ~LibinputJoystick() override;
 
-    // Override methods from Joystick
-    int getFd() const override;
-    void update() override;
-
-    int getAxisState(int id) override;
-
-    // Static helper methods
-    static std::vector<LibinputJoystick*> getJoysticks();
-
-    // Calibration methods
-    std::vector<CalibrationData> getCalibration() override;
-    void setCalibration(const std::vector<CalibrationData>& data) override;
-    void resetCalibration() override;
-    void clearCalibration() override;
-
-    // Mapping methods
-    std::vector<int> getButtonMapping() override;
-    std::vector<int> getAxisMapping() override;
-    void setButtonMapping(const std::vector<int>& mapping) override;
-    void setAxisMapping(const std::vector<int>& mapping) override;
-    void correctCalibration(const std::vector<int>& mapping_old, const std::vector<int>& mapping_new) override;
+    // There is no fd to read, libinput does that
+    bool supportsThreadedReading() const override { return false; }
 
-    // Get the evdev that this joystick device is based on
-    std::string getEvdev() const override;
-
-private slots:
-    void onSocketActivated(int socket);
+    // The device has to be opened again from the list, it was looked up
+    // through udev from a syspath that is gone now
+    bool supportsReconnect() const override { return false; }
 
 private:
     // Initialize device-specific resources
     bool initDevice();
-    
-    // Process libinput events
-    void processEvent();
-    
-    // Apply calibration to raw axis values
-    int applyCalibration(int axis, int value);
+
+    // JoystickEventHub::LibinputListener
+    void handleLibinputEvent(struct libinput_event* event) override;
+    void finishLibinputDispatch() override;
     
     // Prohibit copying
     LibinputJoystick(const LibinputJoystick&) = delete;
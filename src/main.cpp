@@ -27,56 +27,51 @@
 #include <QProcess>
 #include <QDebug>
 
+#include "frame_presenter.h"
 #include "joystick.h"
 #include "joystick_factory.h"
+#include "joystick_monitor.h"
+#ifdef HAVE_LIBURING
+#  include "joystick_uring.h"
+#endif
 #include "dialogs/joystick_test_dialog.h"
 #include "dialogs/joystick_list_dialog.h"
 #include "dialogs/joystick_map_dialog.h"
 #include "dialogs/joystick_calibration_dialog.h"
 #include "utils/dialog_helper.h"
+#include "utils/libinput_helper.h"
+#include "utils/wayland_helper.h"
 
 // Static member initialization
 JoystickApp* JoystickApp::m_instance = nullptr;
 
-JoystickGui::JoystickGui(std::unique_ptr<Joystick> joystick, bool simple_ui, QWidget* parent) :
-    QObject(nullptr),
-    m_joystick(std::move(joystick)),
-    m_test_dialog()
-{
-    // Create test dialog as a new top-level window
-    m_test_dialog = std::make_unique<JoystickTestDialog>(*this, *m_joystick, simple_ui);
-    
-    // Force dialog to be a separate window regardless of parent
-    m_test_dialog->setWindowFlags(Qt::Window);
-}
-
-void
-JoystickGui::showCalibrationDialog()
-{
-    // Instead of creating a dialog directly, launch it in a separate process
-    DialogManager::showCalibrationDialog(QString::fromStdString(m_joystick->getFilename()));
-}
-
-void
-JoystickGui::showMappingDialog()
-{
-    // Instead of creating a dialog directly, launch it in a separate process
-    DialogManager::showMappingDialog(QString::fromStdString(m_joystick->getFilename()));
-}
-
 JoystickApp::JoystickApp(int& argc, char** argv) :
     QApplication(argc, argv),
     m_datadir("resources/"),
     m_simple_ui(false),
+    m_reader_thread(false),
     m_joystick_guis()
 {
     m_instance = this;
     setApplicationName("jstest-qt");
     setApplicationVersion("0.1.1");
+
+    connect(JoystickMonitor::instance(), &JoystickMonitor::deviceAdded, this, &JoystickApp::onDeviceAdded);
 }
 
 JoystickApp::~JoystickApp()
 {
+    // The hub and the helpers own QSocketNotifiers, which need our event
+    // dispatcher, so they go now in reverse order of their dependencies
+    // instead of with the other statics after main() returned
+    m_joystick_guis.clear();
+    WaylandInputHelper::destroy();
+    LibinputHelper::instance()->shutdown();
+#ifdef HAVE_LIBURING
+    JoystickUring::destroy();
+#endif
+    JoystickMonitor::destroy();
+    JoystickEventHub::destroy();
 }
 
 JoystickTestDialog*
@@ -96,6 +91,10 @@ JoystickApp::showDevicePropertyDialog(const QString& filename, QWidget* parent)
             // Create joystick using factory - this will automatically select the best backend
             std::unique_ptr<Joystick> joystick = JoystickFactory::createJoystick(filename.toStdString());
             
+            if (m_reader_thread && !joystick->setThreadedReading(true)) {
+                qDebug() << "Backend does not support a reader thread, reading on the GUI thread";
+            }
+            
             // IMPORTANT: Pass nullptr as parent to ensure it's a top-level window
             std::shared_ptr<JoystickGui> gui = std::make_shared<JoystickGui>(std::move(joystick), m_simple_ui, nullptr);
             
@@ -125,6 +124,28 @@ JoystickApp::showDevicePropertyDialog(const QString& filename, QWidget* parent)
     }
 }
 
+void
+JoystickApp::onDeviceAdded(const QString& devnode, const QString& syspath)
+{
+    auto it = m_joystick_guis.find(devnode);
+    if (it == m_joystick_guis.end()) {
+        it = m_joystick_guis.find(syspath);
+    }
+    if (it == m_joystick_guis.end()) {
+        return;
+    }
+
+    Joystick* joystick = it.value()->getJoystick();
+    if (!joystick->supportsReconnect()) {
+        qDebug() << it.key() << "is back, but its backend can't reconnect, open it again from the list";
+        return;
+    }
+
+    if (!joystick->reconnect()) {
+        qDebug() << "Could not reconnect" << it.key() << ", the device changed or can't be opened";
+    }
+}
+
 int
 JoystickApp::run()
 {
@@ -148,6 +169,20 @@ JoystickApp::run()
     QCommandLineOption libinputOption("libinput", "Force libinput backend");
     parser.addOption(libinputOption);
     
+    QCommandLineOption evdevOption("evdev", "Force direct evdev backend");
+    parser.addOption(evdevOption);
+    
+    QCommandLineOption readerThreadOption("reader-thread", "Read device events on a separate thread");
+    parser.addOption(readerThreadOption);
+
+    QCommandLineOption maxFpsOption("max-fps", "Update the test dialog at most FPS times per second, 0 updates on every event", "fps");
+    parser.addOption(maxFpsOption);
+    
+#ifdef HAVE_LIBURING
+    QCommandLineOption ioUringOption("io-uring", "Read devices through io_uring");
+    parser.addOption(ioUringOption);
+#endif
+    
     QCommandLineOption externalDialogOption("external-dialog", "Launch as an external dialog");
     parser.addOption(externalDialogOption);
     
@@ -157,6 +192,26 @@ JoystickApp::run()
         m_simple_ui = true;
     }
     
+    if (parser.isSet(readerThreadOption)) {
+        m_reader_thread = true;
+    }
+
+    if (parser.isSet(maxFpsOption)) {
+        bool ok = false;
+        int max_fps = parser.value(maxFpsOption).toInt(&ok);
+        if (!ok || max_fps < 0) {
+            std::cerr << "Error: invalid --max-fps value: " << parser.value(maxFpsOption).toStdString() << std::endl;
+            return EXIT_FAILURE;
+        }
+        FramePresenter::setDefaultMaxFps(max_fps);
+    }
+    
+#ifdef HAVE_LIBURING
+    if (parser.isSet(ioUringOption)) {
+        JoystickUring::setEnabled(true);
+    }
+#endif
+    
     if (parser.isSet(datadirOption)) {
         m_datadir = parser.value(datadirOption);
         if (!m_datadir.endsWith('/')) {
@@ -173,6 +228,8 @@ JoystickApp::run()
         JoystickFactory::setDefaultBackend(JoystickBackend::LEGACY);
     } else if (parser.isSet(libinputOption)) {
         JoystickFactory::setDefaultBackend(JoystickBackend::LIBINPUT);
+    } else if (parser.isSet(evdevOption)) {
+        JoystickFactory::setDefaultBackend(JoystickBackend::EVDEV);
     }
     
     // Handle external dialog requests
@@ -25,34 +25,10 @@
 #include <QMap>
 #include <memory>
 
-class Joystick;
+#include "joystick_gui.h"
+
 class QWidget;
 class JoystickListDialog;
-class JoystickTestDialog;
-class JoystickMapDialog;
-class JoystickCalibrationDialog;
-
-class JoystickGui : public QObject
-{
-    Q_OBJECT
-
-private:
-    std::unique_ptr<Joystick> m_joystick;
-    std::unique_ptr<JoystickTestDialog> m_test_dialog;
-    std::unique_ptr<JoystickMapDialog> m_mapping_dialog;
-    std::unique_ptr<JoystickCalibrationDialog> m_calibration_dialog;
-
-public:
-    JoystickGui(std::unique_ptr<Joystick> joystick,
-                bool simple_ui,
-                QWidget* parent = nullptr);
-
-    JoystickTestDialog* getTestDialog() const { return m_test_dialog.get(); }
-
-public slots:
-    void showCalibrationDialog();
-    void showMappingDialog();
-};
 
 class JoystickApp : public QApplication
 {
@@ -63,6 +39,7 @@ private:
     
     QString m_datadir;
     bool m_simple_ui;
+    bool m_reader_thread;
 
     QMap<QString, std::shared_ptr<JoystickGui>> m_joystick_guis;
 
@@ -76,6 +53,11 @@ public:
     
     int run();
     QString getDataDirectory() const { return m_datadir; }
+
+private slots:
+    /** Reattach an open test dialog to its device when it gets plugged
+        back in */
+    void onDeviceAdded(const QString& devnode, const QString& syspath);
 };
 
 #endif // JSTEST_QT_MAIN_H
@@ -1,6 +1,5 @@
 /*
 **  jstest-qt - A Qt joystick tester
-**  Copyright (C) 2009 Ingo Ruhnke <grumbel@gmail.com>
 **  Copyright (C) 2025 Qt port contributors
 **
 **  This program is free software: you can redistribute it and/or modify
@@ -17,27 +16,31 @@
 **  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#ifndef JSTEST_QT_BUTTON_WIDGET_H
-#define JSTEST_QT_BUTTON_WIDGET_H
+#ifndef JSTEST_QT_BENCH_UTIL_H
+#define JSTEST_QT_BENCH_UTIL_H
 
-#include <QWidget>
-#include <QString>
+// Helpers shared by the benchmarks and stress tests in src/tools
 
-class ButtonWidget : public QWidget
+#include <stdio.h>
+#include <unistd.h>
+
+/** Resident memory of the calling process in kB, -1 on error */
+static inline long resident_kb()
 {
-    Q_OBJECT
+    long size = 0;
+    long resident = 0;
 
-private:
-    QString name;
-    bool down;
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file)
+        return -1;
 
-public:
-    ButtonWidget(int width, int height, const QString& name, QWidget* parent = nullptr);
+    int fields = fscanf(file, "%ld %ld", &size, &resident);
+    fclose(file);
 
-    void paintEvent(QPaintEvent* event) override;
+    if (fields != 2)
+        return -1;
 
-public slots:
-    void setDown(bool t);
-};
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
 
-#endif // JSTEST_QT_BUTTON_WIDGET_H
+#endif // JSTEST_QT_BENCH_UTIL_H
@@ -0,0 +1,261 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Benchmark for device enumeration. Compares probing every event node
+// with EVIOCGBIT, the way enumeration used to work, against the sysfs
+// topology with a cold and with a warm capability cache. The cache is
+// kept in a temporary file, the one of the application is not touched.
+//
+// Machines with few input devices show little more than the cost of
+// opening the cache file, so the cache is also measured on a synthetic
+// sysfs tree with as many joysticks as asked for. The EVIOCGBIT probe
+// always runs against the real /dev/input.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/input.h>
+
+#include "../utils/capability_cache.h"
+#include "../utils/evdev_helper.h"
+#include "../utils/sysfs_topology.h"
+
+static double now_us()
+{
+    using namespace std::chrono;
+    return duration_cast<duration<double, std::micro>>(steady_clock::now().time_since_epoch()).count();
+}
+
+// The old way: open every event node and query its capabilities
+static int enumerate_probe()
+{
+    int joysticks = 0;
+
+    DIR* dir = opendir("/dev/input");
+    if (!dir)
+        return 0;
+
+    while (struct dirent* entry = readdir(dir)) {
+        if (strncmp(entry->d_name, "event", 5) != 0)
+            continue;
+
+        std::string path = std::string("/dev/input/") + entry->d_name;
+        int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd < 0)
+            continue;
+
+        unsigned long evbit[NLONGS(EV_CNT)] = { 0 };
+        unsigned long absbit[NLONGS(ABS_CNT)] = { 0 };
+        unsigned long keybit[NLONGS(KEY_CNT)] = { 0 };
+        ioctl(fd, EVIOCGBIT(0, sizeof(evbit)), evbit);
+        ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absbit)), absbit);
+        ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keybit)), keybit);
+        close(fd);
+
+        int axes = 0;
+        for (int i = 0; i < ABS_CNT; i++) {
+            if (absbit[BIT_WORD(i)] & BIT_MASK(i))
+                axes++;
+        }
+        int buttons = 0;
+        for (int i = BTN_MISC; i < KEY_CNT; i++) {
+            if (keybit[BIT_WORD(i)] & BIT_MASK(i))
+                buttons++;
+        }
+
+        if ((evbit[BIT_WORD(EV_ABS)] & BIT_MASK(EV_ABS)) && axes > 0 && buttons > 0)
+            joysticks++;
+    }
+
+    closedir(dir);
+    return joysticks;
+}
+
+static void write_file(const std::string& path, const std::string& content)
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) {
+        std::cerr << path << ": " << strerror(errno) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    fprintf(file, "%s\n", content.c_str());
+    fclose(file);
+}
+
+// A /sys/class/input lookalike with count gamepads, each a different
+// model so a cold cache misses on every one of them
+static void make_tree(const std::string& root, int count)
+{
+    mkdir(root.c_str(), 0700);
+    for (int i = 0; i < count; ++i) {
+        std::string dir = root + "/input" + std::to_string(i);
+        mkdir(dir.c_str(), 0700);
+        mkdir((dir + "/id").c_str(), 0700);
+        mkdir((dir + "/capabilities").c_str(), 0700);
+        mkdir((dir + "/event" + std::to_string(i)).c_str(), 0700);
+
+        char product[8];
+        snprintf(product, sizeof(product), "%04X", 0x1000 + i);
+
+        write_file(dir + "/name", "Synthetic Gamepad " + std::to_string(i));
+        write_file(dir + "/phys", "usb-0000:00:14.0-" + std::to_string(i) + "/input0");
+        write_file(dir + "/uniq", "");
+        write_file(dir + "/modalias", std::string("input:b0003v1234p") + product +
+                   "e0111-e0,1,3,15,k120,121,122,123,124,125,126,127,128,129,12A,12B,ra0,1,2,5,10,11,m4,lsfw");
+        write_file(dir + "/id/bustype", "0003");
+        write_file(dir + "/id/vendor", "1234");
+        write_file(dir + "/id/product", product);
+        write_file(dir + "/id/version", "0111");
+        write_file(dir + "/capabilities/ev", "20000b");
+        write_file(dir + "/capabilities/abs", "30027");
+        write_file(dir + "/capabilities/key", "fff00000000 0 0 0 0");
+    }
+}
+
+static void remove_tree(const std::string& root, int count)
+{
+    static const char* const files[] = {
+        "name", "phys", "uniq", "modalias", "id/bustype", "id/vendor", "id/product", "id/version",
+        "capabilities/ev", "capabilities/abs", "capabilities/key"
+    };
+    for (int i = 0; i < count; ++i) {
+        std::string dir = root + "/input" + std::to_string(i);
+        for (const char* file : files) {
+            unlink((dir + "/" + file).c_str());
+        }
+        rmdir((dir + "/event" + std::to_string(i)).c_str());
+        rmdir((dir + "/id").c_str());
+        rmdir((dir + "/capabilities").c_str());
+        rmdir(dir.c_str());
+    }
+    rmdir(root.c_str());
+}
+
+static int enumerate_cached(CapabilityCache& cache, const std::string& root)
+{
+    int joysticks = 0;
+
+    SysfsTopology topology(root);
+    for (const SysfsTopology::InputDevice& device : topology.getDevices()) {
+        if (!device.event.empty() && cache.get(device).isJoystick())
+            joysticks++;
+    }
+
+    return joysticks;
+}
+
+struct CacheTimes {
+    double cold_us;
+    double warm_us;
+    int joysticks;
+    size_t devices;
+};
+
+// Cold: no cache file yet, every device is a miss and gets stored.
+// Warm: loading the file is part of what a warm start pays for.
+static CacheTimes bench_cache(const std::string& root, int rounds)
+{
+    std::string filename = "/tmp/jstest-qt-enum-bench." + std::to_string(getpid()) + ".bin";
+
+    CacheTimes times = { 0.0, 0.0, 0, SysfsTopology(root).getDevices().size() };
+    for (int round = 0; round < rounds; ++round) {
+        unlink(filename.c_str());
+        double start = now_us();
+        {
+            CapabilityCache cache(filename);
+            times.joysticks = enumerate_cached(cache, root);
+            cache.save();
+        }
+        times.cold_us += now_us() - start;
+
+        start = now_us();
+        {
+            CapabilityCache cache(filename);
+            enumerate_cached(cache, root);
+        }
+        times.warm_us += now_us() - start;
+    }
+    unlink(filename.c_str());
+
+    times.cold_us /= rounds;
+    times.warm_us /= rounds;
+    return times;
+}
+
+static void report(const std::string& title, const CacheTimes& times)
+{
+    std::cout << title << ", " << times.devices << " input devices" << std::endl
+              << std::fixed << std::setprecision(2)
+              << std::setw(24) << "sysfs cold cache us" << std::setw(12) << times.cold_us
+              << std::setw(8) << times.joysticks << " joysticks" << std::endl
+              << std::setw(24) << "sysfs warm cache us" << std::setw(12) << times.warm_us
+              << std::setw(8) << times.joysticks << " joysticks" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    int rounds = 100;
+    int synthetic = 64;
+    std::string root = "/sys/class/input";
+    if (argc > 1) {
+        rounds = std::max(1, atoi(argv[1]));
+    }
+    if (argc > 2) {
+        synthetic = std::max(0, atoi(argv[2]));
+    }
+    if (argc > 3) {
+        root = argv[3];
+    }
+
+    double probe_us = 0.0;
+    int probe_count = 0;
+    for (int round = 0; round < rounds; ++round) {
+        double start = now_us();
+        probe_count = enumerate_probe();
+        probe_us += now_us() - start;
+    }
+
+    std::cout << "Enumeration benchmark, " << rounds << " rounds" << std::endl
+              << std::fixed << std::setprecision(2)
+              << std::setw(24) << "EVIOCGBIT probe us" << std::setw(12) << probe_us / rounds
+              << std::setw(8) << probe_count << " joysticks" << std::endl << std::endl;
+
+    report(root, bench_cache(root, rounds));
+
+    if (synthetic > 0) {
+        std::string tree = "/tmp/jstest-qt-enum-bench." + std::to_string(getpid()) + ".sysfs";
+        make_tree(tree, synthetic);
+        std::cout << std::endl;
+        report("Synthetic tree", bench_cache(tree, rounds));
+        remove_tree(tree, synthetic);
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Benchmark for the event name lookups in evdev_helper. Runs btn2str(),
+// abs2str(), rel2str() over every code and str2event() over every name
+// they return, next to the per-type std::map lookups the tables replaced.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <linux/input.h>
+
+#include "../utils/evdev_helper.h"
+
+static double now_ns()
+{
+    using namespace std::chrono;
+    return duration_cast<duration<double, std::nano>>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Keeps the compiler from throwing away the results
+static volatile size_t sink;
+
+int main(int argc, char** argv)
+{
+    int rounds = 1000;
+    if (argc > 1) {
+        rounds = std::max(1, atoi(argv[1]));
+    }
+
+    // Every code that has a name, as the tables see it, and the way the
+    // names used to be looked up, a pair of maps per event type since the
+    // codes of different types overlap
+    struct EventType {
+        int count;
+        std::string (*to_str)(int);
+        std::vector<std::pair<std::string, int>> names;
+        std::map<std::string, int> string2code;
+        std::map<int, std::string> code2string;
+    };
+    EventType types[] = {
+        { KEY_CNT, btn2str, {}, {}, {} },
+        { ABS_CNT, abs2str, {}, {}, {} },
+        { REL_CNT, rel2str, {}, {}, {} },
+    };
+
+    size_t name_count = 0;
+    for (EventType& type : types) {
+        for (int code = 0; code < type.count; code++) {
+            std::string name = type.to_str(code);
+            if (name.compare(0, 4, "KEY_") == 0 || name.compare(0, 4, "BTN_") == 0 ||
+                name.compare(0, 4, "ABS_") == 0 || name.compare(0, 4, "REL_") == 0)
+                type.names.emplace_back(name, code);
+        }
+        name_count += type.names.size();
+    }
+
+    double start = now_ns();
+    for (EventType& type : types) {
+        for (const auto& it : type.names) {
+            type.string2code[it.first] = it.second;
+            type.code2string[it.second] = it.first;
+        }
+    }
+    double map_build_ns = now_ns() - start;
+
+    double to_str_ns = 0.0;
+    double from_str_ns = 0.0;
+    double map_to_str_ns = 0.0;
+    double map_from_str_ns = 0.0;
+
+    for (int round = 0; round < rounds; ++round) {
+        size_t total = 0;
+
+        start = now_ns();
+        for (const EventType& type : types) {
+            for (int code = 0; code < type.count; code++)
+                total += type.to_str(code).size();
+        }
+        to_str_ns += now_ns() - start;
+
+        start = now_ns();
+        for (const EventType& type : types) {
+            for (const auto& it : type.names) {
+                int event_type;
+                int code;
+                str2event(it.first, event_type, code);
+                total += code;
+            }
+        }
+        from_str_ns += now_ns() - start;
+
+        start = now_ns();
+        for (const EventType& type : types) {
+            for (int code = 0; code < type.count; code++) {
+                auto found = type.code2string.find(code);
+                total += found != type.code2string.end() ? found->second.size() : std::to_string(code).size();
+            }
+        }
+        map_to_str_ns += now_ns() - start;
+
+        start = now_ns();
+        for (const EventType& type : types) {
+            for (const auto& it : type.names)
+                total += type.string2code.find(it.first)->second;
+        }
+        map_from_str_ns += now_ns() - start;
+
+        sink = total;
+    }
+
+    int codes = KEY_CNT + ABS_CNT + REL_CNT;
+    std::cout << "Event name benchmark, " << rounds << " rounds, "
+              << name_count << " names, " << codes << " codes" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(28) << "code -> name ns/lookup" << std::setw(10) << to_str_ns / rounds / codes
+              << "   std::map " << map_to_str_ns / rounds / codes << std::endl
+              << std::setw(28) << "name -> code ns/lookup" << std::setw(10) << from_str_ns / rounds / name_count
+              << "   std::map " << map_from_str_ns / rounds / name_count << std::endl
+              << std::setw(28) << "std::map setup us" << std::setw(10) << map_build_ns / 1000.0
+              << "   tables 0.0, built at compile time" << std::endl;
+
+    return 0;
+}
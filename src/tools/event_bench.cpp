@@ -0,0 +1,357 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Benchmark for the event dispatch path with many devices. uinput
+// devices stand in for joysticks, every round moves the X axis of each
+// of them and measures how long it takes until all of their evdev nodes
+// have been drained, once with a QSocketNotifier per fd, once through
+// JoystickEventHub and, when built with io_uring support, once through
+// JoystickUring. The nodes are opened O_NONBLOCK like Joystick does.
+// "idle cpu" is the CPU time used while no device sends anything, which
+// has to stay near zero for every path. Needs write access to
+// /dev/uinput.
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <linux/uinput.h>
+
+#include "../joystick_event_hub.h"
+#ifdef HAVE_LIBURING
+#  include "../joystick_uring.h"
+#endif
+
+// Milliseconds every path sits idle to measure its CPU use
+static const int IDLE_MS = 250;
+
+struct Device {
+    int rd;     // evdev node
+    int wr;     // uinput
+};
+
+// Evdev node of a uinput device, e.g. /dev/input/event17
+static std::string find_event_node(int uinput_fd)
+{
+    char sysname[64];
+    if (ioctl(uinput_fd, UI_GET_SYSNAME(sizeof(sysname)), sysname) < 0) {
+        std::cerr << "UI_GET_SYSNAME failed: " << strerror(errno) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string sysdir = std::string("/sys/devices/virtual/input/") + sysname;
+    DIR* dir = opendir(sysdir.c_str());
+    if (!dir) {
+        std::cerr << sysdir << ": " << strerror(errno) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string node;
+    while (struct dirent* entry = readdir(dir)) {
+        if (strncmp(entry->d_name, "event", 5) == 0) {
+            node = std::string("/dev/input/") + entry->d_name;
+            break;
+        }
+    }
+    closedir(dir);
+
+    if (node.empty()) {
+        std::cerr << sysdir << ": no event node" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return node;
+}
+
+static std::vector<Device> open_devices(int count)
+{
+    std::vector<Device> devices;
+    for (int i = 0; i < count; ++i) {
+        int wr = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+        if (wr < 0) {
+            std::cerr << "/dev/uinput: " << strerror(errno) << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        struct uinput_abs_setup abs;
+        memset(&abs, 0, sizeof(abs));
+        abs.code = ABS_X;
+        abs.absinfo.minimum = 0;
+        abs.absinfo.maximum = 255;
+
+        struct uinput_setup setup;
+        memset(&setup, 0, sizeof(setup));
+        setup.id.bustype = BUS_VIRTUAL;
+        snprintf(setup.name, UINPUT_MAX_NAME_SIZE, "event_bench %d", i);
+
+        if (ioctl(wr, UI_SET_EVBIT, EV_ABS) < 0 ||
+            ioctl(wr, UI_SET_ABSBIT, ABS_X) < 0 ||
+            ioctl(wr, UI_ABS_SETUP, &abs) < 0 ||
+            ioctl(wr, UI_DEV_SETUP, &setup) < 0 ||
+            ioctl(wr, UI_DEV_CREATE) < 0) {
+            std::cerr << "creating uinput device failed: " << strerror(errno) << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        // devtmpfs creates the node right away, but give udev a moment to
+        // fix up the permissions
+        std::string node = find_event_node(wr);
+        int rd = -1;
+        for (int tries = 0; rd < 0 && tries < 100; ++tries) {
+            rd = open(node.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+            if (rd < 0) {
+                usleep(10000);
+            }
+        }
+        if (rd < 0) {
+            std::cerr << node << ": " << strerror(errno) << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        devices.push_back({ rd, wr });
+    }
+    return devices;
+}
+
+static void close_devices(std::vector<Device>& devices)
+{
+    for (const Device& d : devices) {
+        close(d.rd);
+        ioctl(d.wr, UI_DEV_DESTROY);
+        close(d.wr);
+    }
+    devices.clear();
+}
+
+// Read everything from fd like Joystick::update() does
+static void drain(int fd, int& pending)
+{
+    struct input_event events[64];
+    bool got_data = false;
+    while (read(fd, events, sizeof(events)) > 0) {
+        got_data = true;
+    }
+    if (got_data) {
+        pending -= 1;
+    }
+}
+
+// Percentage of one core used while running the event loop with nothing
+// to do
+static double idle_cpu()
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &start);
+
+    QEventLoop loop;
+    QTimer::singleShot(IDLE_MS, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &end);
+    double cpu_ms = (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+    return cpu_ms * 100.0 / IDLE_MS;
+}
+
+// Returns the average time of one round in microseconds
+static double run_rounds(const std::vector<Device>& devices, int rounds, int& pending)
+{
+    struct input_event events[2];
+    memset(events, 0, sizeof(events));
+    events[0].type = EV_ABS;
+    events[0].code = ABS_X;
+    events[1].type = EV_SYN;
+    events[1].code = SYN_REPORT;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int r = 0; r < rounds; ++r) {
+        // evdev drops values that didn't change
+        events[0].value = r & 0xff;
+
+        pending = static_cast<int>(devices.size());
+        for (const Device& d : devices) {
+            if (write(d.wr, events, sizeof(events)) < 0) {
+                std::cerr << "write() failed: " << strerror(errno) << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        while (pending > 0) {
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        }
+    }
+
+    return static_cast<double>(timer.nsecsElapsed()) / 1000.0 / rounds;
+}
+
+static double bench_notifiers(const std::vector<Device>& devices, int rounds, double& idle)
+{
+    std::vector<std::unique_ptr<QSocketNotifier>> notifiers;
+    int pending = 0;
+
+    for (const Device& d : devices) {
+        int fd = d.rd;
+        notifiers.push_back(std::make_unique<QSocketNotifier>(fd, QSocketNotifier::Read));
+        QObject::connect(notifiers.back().get(), &QSocketNotifier::activated,
+                         [fd, &pending]() { drain(fd, pending); });
+    }
+
+    double result = run_rounds(devices, rounds, pending);
+    idle = idle_cpu();
+
+    notifiers.clear();
+    return result;
+}
+
+static double bench_hub(const std::vector<Device>& devices, int rounds, double& dispatches, double& idle)
+{
+    JoystickEventHub* hub = JoystickEventHub::instance();
+    int pending = 0;
+
+    for (const Device& d : devices) {
+        int fd = d.rd;
+        hub->addWatch(fd, [fd, &pending]() { drain(fd, pending); });
+    }
+
+    uint64_t dispatch_start = hub->getDispatchCount();
+    double result = run_rounds(devices, rounds, pending);
+    dispatches = static_cast<double>(hub->getDispatchCount() - dispatch_start) / rounds;
+    idle = idle_cpu();
+
+    for (const Device& d : devices) {
+        hub->removeWatch(d.rd);
+    }
+    return result;
+}
+
+#ifdef HAVE_LIBURING
+static double bench_uring(const std::vector<Device>& devices, int rounds, double& submits, double& idle)
+{
+    JoystickUring* uring = JoystickUring::instance();
+    int pending = 0;
+
+    for (const Device& d : devices) {
+        uring->addRead(d.rd, JoystickUring::BUFFER_SIZE, [&pending](const char* data, int result) {
+            if (result > 0) {
+                pending -= 1;
+            }
+        });
+    }
+
+    uint64_t submit_start = uring->getSubmitCount();
+    double result = run_rounds(devices, rounds, pending);
+    submits = static_cast<double>(uring->getSubmitCount() - submit_start) / rounds;
+    idle = idle_cpu();
+
+    for (const Device& d : devices) {
+        uring->removeRead(d.rd);
+    }
+    return result;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int rounds = 2000;
+    int max_devices = 128;
+    if (argc > 1) {
+        rounds = std::max(1, atoi(argv[1]));
+    }
+    if (argc > 2) {
+        max_devices = std::max(1, atoi(argv[2]));
+    }
+
+#ifdef HAVE_LIBURING
+    JoystickUring::setEnabled(true);
+    bool have_uring = JoystickUring::instance() != nullptr;
+    max_devices = std::min(max_devices, static_cast<int>(JoystickUring::MAX_SLOTS));
+#else
+    bool have_uring = false;
+#endif
+
+    std::cout << "Event dispatch benchmark, " << rounds << " rounds of one event per device" << std::endl;
+    std::cout << std::setw(8) << "devices"
+              << std::setw(16) << "notifier us"
+              << std::setw(16) << "idle cpu %"
+              << std::setw(16) << "hub us"
+              << std::setw(16) << "hub us/dev"
+              << std::setw(16) << "epoll calls"
+              << std::setw(16) << "idle cpu %";
+    if (have_uring) {
+        std::cout << std::setw(16) << "uring us"
+                  << std::setw(16) << "uring us/dev"
+                  << std::setw(16) << "submits"
+                  << std::setw(16) << "idle cpu %";
+    }
+    std::cout << std::endl;
+
+    for (int count = 1; count <= max_devices; count *= 2) {
+        std::vector<Device> devices = open_devices(count);
+
+        double dispatches = 0.0;
+        double notifier_idle = 0.0;
+        double hub_idle = 0.0;
+        double notifier_us = bench_notifiers(devices, rounds, notifier_idle);
+        double hub_us = bench_hub(devices, rounds, dispatches, hub_idle);
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(8) << count
+                  << std::setw(16) << notifier_us
+                  << std::setw(16) << notifier_idle
+                  << std::setw(16) << hub_us
+                  << std::setw(16) << hub_us / count
+                  << std::setw(16) << dispatches
+                  << std::setw(16) << hub_idle;
+
+#ifdef HAVE_LIBURING
+        if (have_uring) {
+            double submits = 0.0;
+            double uring_idle = 0.0;
+            double uring_us = bench_uring(devices, rounds, submits, uring_idle);
+            std::cout << std::setw(16) << uring_us
+                      << std::setw(16) << uring_us / count
+                      << std::setw(16) << submits
+                      << std::setw(16) << uring_idle;
+        }
+#endif
+        std::cout << std::endl;
+
+        close_devices(devices);
+    }
+
+    return 0;
+}
@@ -0,0 +1,294 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Benchmark for the paint cost of the axis, rudder and throttle widgets.
+// Every round moves the widget and renders it into an image, once for
+// the widgets as they are and once for copies of the old paintEvent()
+// code, which drew the complete widget on every paint.
+//
+// The last part checks that recording stick positions for the trail and
+// the heatmap costs the same per event early and late in a long session.
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../widgets/axis_widget.h"
+#include "../widgets/rudder_widget.h"
+#include "../widgets/throttle_widget.h"
+
+class LegacyAxisWidget : public QWidget
+{
+public:
+    double x = 0;
+    double y = 0;
+    int raw_x = 0;
+    int raw_y = 0;
+
+    LegacyAxisWidget(int width, int height) { setFixedSize(width, height); }
+
+    void setRawX(int value) { raw_x = value; x = value / 32767.0; update(); }
+    void setRawY(int value) { raw_y = value; y = value / 32767.0; update(); }
+
+    void paintEvent(QPaintEvent*) override
+    {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+
+        int w = width() - 10;
+        int h = height() - 10;
+        int px = w/2 + (w/2 * x);
+        int py = h/2 + (h/2 * y);
+
+        painter.translate(5, 5);
+
+        QPainterPath rectPath;
+        rectPath.addRect(0, 0, w, h);
+        painter.setPen(Qt::black);
+        painter.drawPath(rectPath);
+
+        QPainterPath circlePath;
+        circlePath.addEllipse(w/2 - w/2, h/2 - w/2, w, w);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QBrush(QColor(0, 0, 0, 25)));
+        painter.drawPath(circlePath);
+
+        painter.setPen(QPen(QColor(0, 0, 0, 128), 0.5));
+        painter.drawLine(w/2, 0, w/2, h);
+        painter.drawLine(0, h/2, w, h/2);
+
+        painter.setPen(QPen(Qt::black, 2.0));
+        painter.drawLine(px, py-5, px, py+5);
+        painter.drawLine(px-5, py, px+5, py);
+
+        std::ostringstream value_text;
+        value_text << "X: " << std::setw(6) << raw_x << " Y: " << std::setw(6) << raw_y;
+
+        QFont monospaceFont = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+        monospaceFont.setPointSize(10);
+        painter.setFont(monospaceFont);
+
+        QFontMetrics fm(monospaceFont);
+        QString valueString = QString::fromStdString(value_text.str());
+        QRect textRect = fm.boundingRect(valueString);
+
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QBrush(QColor(255, 255, 255, 179)));
+
+        QPainterPath textBgPath;
+        textBgPath.addRect(w/2 - textRect.width()/2 - 2,
+                           h - textRect.height() - 4,
+                           textRect.width() + 4,
+                           textRect.height() + 2);
+        painter.drawPath(textBgPath);
+
+        painter.setPen(Qt::black);
+        painter.drawText(QPointF(w/2 - textRect.width()/2, h - 4), valueString);
+    }
+};
+
+class LegacyRudderWidget : public QWidget
+{
+public:
+    double pos = 0;
+
+    LegacyRudderWidget(int width, int height) { setFixedSize(width, height); }
+
+    void setPos(double p) { pos = p; update(); }
+
+    void paintEvent(QPaintEvent*) override
+    {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+
+        double p = (pos + 1.0)/2.0;
+        int w = width() - 10;
+        int h = height() - 10;
+
+        painter.translate(5, 5);
+
+        QPainterPath rectPath;
+        rectPath.addRect(0, 0, w, h);
+        painter.setPen(Qt::black);
+        painter.drawPath(rectPath);
+
+        painter.setPen(QPen(QColor(0, 0, 0, 128), 0.5));
+        painter.drawLine(w/2, 0, w/2, h);
+
+        painter.setPen(QPen(Qt::black, 2.0));
+        painter.drawLine(w * p, 0, w * p, h);
+    }
+};
+
+class LegacyThrottleWidget : public QWidget
+{
+public:
+    double pos = 0;
+
+    LegacyThrottleWidget(int width, int height) { setFixedSize(width, height); }
+
+    void setPos(double p) { pos = -p; update(); }
+
+    void paintEvent(QPaintEvent*) override
+    {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+
+        double p = 1.0 - (pos + 1.0) / 2.0;
+        int w = width() - 10;
+        int h = height() - 10;
+
+        painter.translate(5, 5);
+
+        QPainterPath rectPath;
+        rectPath.addRect(0, 0, w, h);
+        painter.setPen(Qt::black);
+        painter.drawPath(rectPath);
+
+        int dh = h * p;
+        painter.setBrush(Qt::black);
+        painter.setPen(Qt::NoPen);
+
+        QPainterPath fillPath;
+        fillPath.addRect(0, h - dh, w, dh);
+        painter.drawPath(fillPath);
+    }
+};
+
+// Average microseconds for moving the widget and rendering it once
+static double measure(QWidget& widget, const std::function<void(int)>& move, int rounds)
+{
+    const qreal dpr = widget.devicePixelRatioF();
+    QImage image(widget.size() * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+
+    // The first paint builds the caches, that is not what we are after
+    move(0);
+    widget.render(&image);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 1; i <= rounds; ++i) {
+        move(i);
+        image.fill(Qt::white);
+        widget.render(&image);
+    }
+    return timer.nsecsElapsed() / 1e3 / rounds;
+}
+
+static void report(const char* name, double legacy_us, double cached_us)
+{
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(10) << name
+              << std::setw(14) << legacy_us
+              << std::setw(14) << cached_us
+              << std::setw(10) << legacy_us / cached_us << "x" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    // Works without a display as well
+    if (qEnvironmentVariableIsEmpty("DISPLAY") && qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+
+    int rounds = 20000;
+    if (argc > 1) {
+        rounds = std::max(1, atoi(argv[1]));
+    }
+
+    auto raw = [](int i) { return int(32767 * sin(i * 0.01)); };
+    auto pos = [](int i) { return sin(i * 0.01); };
+
+    std::cout << "Paint benchmark, " << rounds << " paints per widget, dpr "
+              << app.devicePixelRatio() << std::endl;
+    std::cout << std::setw(10) << "widget"
+              << std::setw(14) << "legacy us"
+              << std::setw(14) << "cached us"
+              << std::setw(11) << "speedup" << std::endl;
+
+    {
+        LegacyAxisWidget legacy(128, 128);
+        AxisWidget cached(128, 128);
+        double legacy_us = measure(legacy, [&](int i) { legacy.setRawX(raw(i)); legacy.setRawY(raw(i + 100)); }, rounds);
+        double cached_us = measure(cached, [&](int i) { cached.setRawX(raw(i)); cached.setRawY(raw(i + 100)); }, rounds);
+        report("axis", legacy_us, cached_us);
+    }
+
+    {
+        LegacyRudderWidget legacy(128, 32);
+        RudderWidget cached(128, 32);
+        double legacy_us = measure(legacy, [&](int i) { legacy.setPos(pos(i)); }, rounds);
+        double cached_us = measure(cached, [&](int i) { cached.setPos(pos(i)); }, rounds);
+        report("rudder", legacy_us, cached_us);
+    }
+
+    {
+        LegacyThrottleWidget legacy(32, 128);
+        ThrottleWidget cached(32, 128, true);
+        double legacy_us = measure(legacy, [&](int i) { legacy.setPos(pos(i)); }, rounds);
+        double cached_us = measure(cached, [&](int i) { cached.setPos(pos(i)); }, rounds);
+        report("throttle", legacy_us, cached_us);
+    }
+
+    {
+        AxisWidget history(128, 128);
+        history.setTrailLength(AxisWidget::DEFAULT_TRAIL_LENGTH);
+        history.setHeatmapEnabled(true);
+
+        const int events = 10000000;
+        const int window = 100000;
+        double first_ns = 0.0;
+        double last_ns = 0.0;
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < events; ++i) {
+            if (i == window) {
+                first_ns = timer.nsecsElapsed() / double(window);
+            }
+            if (i == events - window) {
+                timer.restart();
+            }
+            // Drift around the center with the odd full deflection
+            history.setRawPosition(i % 97 == 0 ? raw(i) : (i * 7919) % 4000 - 1000,
+                                   i % 89 == 0 ? raw(i + 100) : (i * 6151) % 4000 - 1000);
+        }
+        last_ns = timer.nsecsElapsed() / double(window);
+
+        std::cout << std::endl << "Trail and heatmap, " << events << " events" << std::endl
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(24) << "first 100k ns/event" << std::setw(10) << first_ns << std::endl
+                  << std::setw(24) << "last 100k ns/event" << std::setw(10) << last_ns << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Stress test for the LibinputHelper device registry. Refreshes the
+// joystick list over and over and checks that open fds and resident
+// memory stay flat, every refresh after the first has to come out as
+// all unchanged as long as nothing gets plugged in meanwhile.
+
+#include <QCoreApplication>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include "../utils/libinput_helper.h"
+#include "bench_util.h"
+
+static int count_fds()
+{
+    int count = 0;
+
+    DIR* dir = opendir("/proc/self/fd");
+    if (!dir)
+        return -1;
+
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.')
+            count++;
+    }
+
+    closedir(dir);
+    return count - 1;  // the fd of dir itself
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int rounds = 1000;
+    if (argc > 1) {
+        rounds = std::max(1, atoi(argv[1]));
+    }
+
+    LibinputHelper* helper = LibinputHelper::instance();
+    if (!helper->initialize()) {
+        std::cerr << "Failed to initialize libinput" << std::endl;
+        return 1;
+    }
+
+    // The first refresh fills the registry, everything after that should
+    // find it up to date
+    LibinputHelper::RegistryDiff first = helper->refresh();
+    int fds_before = count_fds();
+    long rss_before = resident_kb();
+
+    int added = 0;
+    int removed = 0;
+    for (int round = 0; round < rounds; ++round) {
+        LibinputHelper::RegistryDiff diff = helper->refresh();
+        added += diff.added.size();
+        removed += diff.removed.size();
+    }
+
+    int fds_after = count_fds();
+    long rss_after = resident_kb();
+
+    std::cout << "Registry stress test, " << rounds << " refreshes" << std::endl;
+    std::cout << std::setw(24) << "devices" << std::setw(10) << helper->getDeviceCount()
+              << " (" << first.added.size() << " on first refresh)" << std::endl
+              << std::setw(24) << "libinput handles" << std::setw(10) << helper->getHandleCount()
+              << " (max " << LibinputHelper::MAX_HANDLES << ")" << std::endl
+              << std::setw(24) << "added/removed later" << std::setw(10) << added << "/" << removed << std::endl
+              << std::setw(24) << "open fds" << std::setw(10) << fds_before << " -> " << fds_after << std::endl
+              << std::setw(24) << "resident KiB";
+    if (rss_before < 0 || rss_after < 0) {
+        std::cout << std::setw(10) << "unavailable" << std::endl;
+    } else {
+        std::cout << std::setw(10) << rss_before << " -> " << rss_after << std::endl;
+    }
+
+    helper->shutdown();
+
+    if (fds_after > fds_before) {
+        std::cerr << "File descriptors leaked" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Benchmark for building the test dialog. Creates the dialog for fake
+// devices with 2, 8, 27 and 64 axes, with and without --simple, and
+// reports the time until the first paint has gone through, the number
+// of widgets and how much resident memory it took. Every configuration
+// runs in its own process so they don't share a heap.
+//
+// The second part feeds an 8 axis device with 1000 frames per second,
+// all axes moving, and reports the CPU time the GUI process spends with
+// the presenter unpaced, following the display and capped at 60, 144
+// and 240 Hz.
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QTimer>
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "../joystick.h"
+#include "../joystick_gui.h"
+#include "../dialogs/joystick_test_dialog.h"
+#include "../frame_presenter.h"
+#include "bench_util.h"
+
+// A joystick that only exists for the dialog to look at
+class BenchJoystick : public Joystick
+{
+public:
+    BenchJoystick(int axes, int buttons)
+        : Joystick()
+    {
+        filename = "/dev/input/bench";
+        name = QString("Bench Joystick %1 axes").arg(axes);
+        axis_count = axes;
+        button_count = buttons;
+        axis_state.resize(axes);
+        frame.resize(axes, buttons);
+    }
+
+    // One device read worth of changes, every axis moves a bit
+    void feed(int tick)
+    {
+        uint64_t time = monotonicTime();
+        for (int i = 0; i < axis_count; ++i) {
+            frameAxis(i, int(32767 * sin(tick * 0.01 + i)), time);
+        }
+        if (tick % 50 == 0 && button_count > 0) {
+            frameButton((tick / 50) % button_count, (tick / 50) % 2 == 0, time);
+        }
+        flushFrame();
+    }
+};
+
+class PaintWatcher : public QObject
+{
+public:
+    bool painted = false;
+
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (event->type() == QEvent::Paint) {
+            painted = true;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+static int run(int argc, char** argv, int axes, bool simple)
+{
+    QApplication app(argc, argv);
+
+    // Qt has its own one time setup cost, keep that out of the numbers
+    {
+        QWidget warmup;
+        warmup.show();
+        app.processEvents();
+    }
+
+    const int buttons = 16;
+    long rss_before = resident_kb();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    JoystickGui gui(std::make_unique<BenchJoystick>(axes, buttons), simple);
+    JoystickTestDialog* dialog = gui.getTestDialog();
+    double construct_ms = timer.nsecsElapsed() / 1e6;
+
+    PaintWatcher watcher;
+    dialog->installEventFilter(&watcher);
+    dialog->show();
+    while (!watcher.painted && timer.elapsed() < 5000) {
+        app.processEvents(QEventLoop::AllEvents, 10);
+    }
+    double paint_ms = timer.nsecsElapsed() / 1e6;
+
+    long rss_after = resident_kb();
+    int widgets = dialog->findChildren<QWidget*>().size();
+
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(6) << axes << std::setw(8) << (simple ? "simple" : "full")
+              << std::setw(9) << widgets
+              << std::setw(14) << construct_ms
+              << std::setw(14) << paint_ms
+              << std::setw(12);
+    if (rss_before < 0 || rss_after < 0) {
+        std::cout << "n/a";
+    } else {
+        std::cout << (rss_after - rss_before);
+    }
+    std::cout << (watcher.painted ? "" : "   (no paint)") << std::endl;
+
+    return 0;
+}
+
+static double cpu_ms()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+}
+
+static int run_events(int argc, char** argv, int max_fps)
+{
+    QApplication app(argc, argv);
+
+    const int axes = 8;
+    const int buttons = 16;
+    const int duration_ms = 3000;
+
+    FramePresenter::setDefaultMaxFps(max_fps);
+
+    auto joystick_ptr = std::make_unique<BenchJoystick>(axes, buttons);
+    BenchJoystick* joystick = joystick_ptr.get();
+    JoystickGui gui(std::move(joystick_ptr), false);
+    JoystickTestDialog* dialog = gui.getTestDialog();
+    dialog->show();
+    app.processEvents();
+
+    int tick = 0;
+    QTimer source;
+    source.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&source, &QTimer::timeout, [&]() { joystick->feed(tick++); });
+
+    QElapsedTimer wall;
+    double cpu_start = cpu_ms();
+    wall.start();
+    source.start(1);
+    QTimer::singleShot(duration_ms, &app, &QApplication::quit);
+    app.exec();
+
+    double cpu = cpu_ms() - cpu_start;
+    double elapsed = wall.nsecsElapsed() / 1e6;
+    const FramePresenter& presenter = dialog->getPresenter();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(10) << (max_fps == FramePresenter::DISPLAY_RATE ? std::string("display")
+                                                                          : std::to_string(max_fps))
+              << std::setw(10) << presenter.getLatchCount() * 1000.0 / elapsed
+              << std::setw(12) << presenter.getPresentCount() * 1000.0 / elapsed
+              << std::setw(10) << cpu
+              << std::setw(8) << 100.0 * cpu / elapsed << "%" << std::endl;
+
+    return 0;
+}
+
+static void run_forked(const std::function<int()>& function)
+{
+    pid_t pid = fork();
+    if (pid == 0) {
+        _exit(function());
+    }
+    if (pid < 0) {
+        perror("fork");
+        exit(1);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char** argv)
+{
+    // Works without a display as well
+    if (qEnvironmentVariableIsEmpty("DISPLAY") && qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    std::cout << std::setw(6) << "axes" << std::setw(8) << "ui"
+              << std::setw(9) << "widgets"
+              << std::setw(14) << "construct ms"
+              << std::setw(14) << "paint ms"
+              << std::setw(12) << "rss KiB" << std::endl;
+    std::cout.flush();
+
+    const int axis_counts[] = { 2, 8, 27, 64 };
+    for (int axes : axis_counts) {
+        for (bool simple : { false, true }) {
+            run_forked([&]() { return run(argc, argv, axes, simple); });
+        }
+    }
+
+    std::cout << std::endl
+              << std::setw(10) << "max fps"
+              << std::setw(10) << "events/s"
+              << std::setw(12) << "presents/s"
+              << std::setw(10) << "cpu ms"
+              << std::setw(9) << "cpu" << std::endl;
+    std::cout.flush();
+
+    const int max_fps_values[] = { FramePresenter::UNPACED, FramePresenter::DISPLAY_RATE, 60, 144, 240 };
+    for (int max_fps : max_fps_values) {
+        run_forked([&]() { return run_events(argc, argv, max_fps); });
+    }
+
+    return 0;
+}
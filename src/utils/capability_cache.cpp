@@ -0,0 +1,233 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "utils/capability_cache.h"
+
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <linux/input.h>
+
+// File layout: a Header followed by header.count Records, all in host
+// byte order, the cache never leaves the machine
+static const char CACHE_MAGIC[4] = { 'J', 'S', 'C', 'C' };
+static const uint32_t CACHE_VERSION = 2;
+
+// Upper bound so the file can't grow forever with devices that change
+// their capabilities, e.g. on every firmware update
+static const size_t MAX_ENTRIES = 4096;
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+};
+
+struct Record {
+    uint16_t bustype;
+    uint16_t vendor;
+    uint16_t product;
+    uint16_t version;
+    uint64_t caps_hash;
+    uint16_t axis_count;
+    uint16_t button_count;
+    uint32_t flags;
+};
+
+static_assert(sizeof(Record) == 24, "Record has to be packed");
+
+static bool make_directory(const std::string& path)
+{
+    return mkdir(path.c_str(), 0700) == 0 || errno == EEXIST;
+}
+
+CapabilityCache* CapabilityCache::instance()
+{
+    static CapabilityCache instance(getDefaultFilename());
+    return &instance;
+}
+
+std::string CapabilityCache::getDefaultFilename()
+{
+    const char* cache_home = getenv("XDG_CACHE_HOME");
+    if (cache_home && cache_home[0] == '/') {
+        return std::string(cache_home) + "/jstest-qt/capabilities.bin";
+    }
+
+    const char* home = getenv("HOME");
+    if (home && home[0] == '/') {
+        return std::string(home) + "/.cache/jstest-qt/capabilities.bin";
+    }
+
+    return std::string();
+}
+
+CapabilityCache::CapabilityCache(const std::string& filename)
+    : m_filename(filename),
+      m_entries(),
+      m_dirty(false),
+      m_hits(0),
+      m_misses(0)
+{
+    load();
+}
+
+CapabilityCache::~CapabilityCache()
+{
+    save();
+}
+
+CapabilityCache::Key CapabilityCache::makeKey(const SysfsTopology::InputDevice& device)
+{
+    return Key{ device.bustype, device.vendor, device.product, device.version, device.caps_hash };
+}
+
+CapabilityCache::Entry CapabilityCache::compute(const SysfsTopology::InputDevice& device_)
+{
+    SysfsTopology::InputDevice device = device_;
+    device.parseCapabilities();
+
+    Entry entry;
+    entry.axis_count = device.getAxisCount();
+    entry.button_count = device.getButtonCount();
+    entry.flags = 0;
+
+    if (device.hasEv(EV_ABS))
+        entry.flags |= Entry::HAS_ABS;
+    if (device.hasEv(EV_KEY))
+        entry.flags |= Entry::HAS_KEY;
+    if (device.hasAbs(ABS_X) && device.hasAbs(ABS_Y))
+        entry.flags |= Entry::HAS_ABS_XY;
+    if (device.hasEv(EV_FF))
+        entry.flags |= Entry::HAS_FORCE_FEEDBACK;
+    if (device.isJoystick())
+        entry.flags |= Entry::HAS_JOYSTICK_BUTTON;
+
+    return entry;
+}
+
+CapabilityCache::Entry CapabilityCache::get(const SysfsTopology::InputDevice& device)
+{
+    Key key = makeKey(device);
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_hits += 1;
+        return it->second;
+    }
+
+    m_misses += 1;
+
+    if (m_entries.size() >= MAX_ENTRIES) {
+        m_entries.clear();
+    }
+
+    Entry entry = compute(device);
+    m_entries[key] = entry;
+    m_dirty = true;
+    return entry;
+}
+
+void CapabilityCache::clear()
+{
+    m_dirty = m_dirty || !m_entries.empty();
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+void CapabilityCache::load()
+{
+    if (m_filename.empty())
+        return;
+
+    FILE* file = fopen(m_filename.c_str(), "rb");
+    if (!file)
+        return;
+
+    Header header;
+    if (fread(&header, sizeof(header), 1, file) == 1 &&
+        memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+        header.version == CACHE_VERSION &&
+        header.count <= MAX_ENTRIES)
+    {
+        std::vector<Record> records(header.count);
+        if (fread(records.data(), sizeof(Record), records.size(), file) == records.size()) {
+            for (const Record& record : records) {
+                Key key{ record.bustype, record.vendor, record.product, record.version, record.caps_hash };
+                m_entries[key] = Entry{ record.axis_count, record.button_count, record.flags };
+            }
+        }
+    }
+
+    // A damaged or outdated file simply gets rewritten on the next save()
+    fclose(file);
+}
+
+bool CapabilityCache::save()
+{
+    if (!m_dirty || m_filename.empty())
+        return true;
+
+    // Create the jstest-qt directory and $XDG_CACHE_HOME itself if needed
+    std::string dir = m_filename.substr(0, m_filename.rfind('/'));
+    std::string parent = dir.substr(0, dir.rfind('/'));
+    if (!parent.empty()) {
+        make_directory(parent);
+    }
+    if (!make_directory(dir)) {
+        return false;
+    }
+
+    // Write to a temporary file and rename it over the old one, so other
+    // instances never see a half written cache
+    std::string tmp_filename = m_filename + ".tmp." + std::to_string(getpid());
+    FILE* file = fopen(tmp_filename.c_str(), "wb");
+    if (!file)
+        return false;
+
+    Header header;
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.count = m_entries.size();
+
+    std::vector<Record> records;
+    records.reserve(m_entries.size());
+    for (const auto& it : m_entries) {
+        const Key& key = it.first;
+        const Entry& entry = it.second;
+        records.push_back(Record{ key.bustype, key.vendor, key.product, key.version, key.caps_hash,
+                                  entry.axis_count, entry.button_count, entry.flags });
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(records.data(), sizeof(Record), records.size(), file) == records.size();
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok || rename(tmp_filename.c_str(), m_filename.c_str()) != 0) {
+        unlink(tmp_filename.c_str());
+        return false;
+    }
+
+    m_dirty = false;
+    return true;
+}
@@ -0,0 +1,115 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_CAPABILITY_CACHE_H
+#define JSTEST_QT_CAPABILITY_CACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <stdint.h>
+
+#include "utils/sysfs_topology.h"
+
+/**
+ * Remembers what enumeration needs to know about a device, keyed by its
+ * ids and the hash of its modalias, which is a single sysfs read. Only
+ * a miss reads and decodes the capability bitmaps. The cache is
+ * kept in $XDG_CACHE_HOME/jstest-qt/capabilities.bin, so on a warm start
+ * devices are recognized without decoding and counting their
+ * capability bitmaps, let alone opening them.
+ */
+class CapabilityCache
+{
+public:
+    struct Key {
+        uint16_t bustype;
+        uint16_t vendor;
+        uint16_t product;
+        uint16_t version;
+        uint64_t caps_hash;
+
+        bool operator==(const Key& other) const {
+            return bustype == other.bustype && vendor == other.vendor &&
+                   product == other.product && version == other.version &&
+                   caps_hash == other.caps_hash;
+        }
+    };
+
+    struct Entry {
+        enum {
+            HAS_ABS             = 1 << 0,
+            HAS_KEY             = 1 << 1,
+            HAS_ABS_XY          = 1 << 2,
+            HAS_FORCE_FEEDBACK  = 1 << 3,
+            HAS_JOYSTICK_BUTTON = 1 << 4
+        };
+
+        uint16_t axis_count;
+        uint16_t button_count;  // joydev numbering, BTN_MISC and up
+        uint32_t flags;
+
+        bool has(uint32_t flag) const { return (flags & flag) == flag; }
+        bool isJoystick() const { return has(HAS_ABS | HAS_KEY | HAS_JOYSTICK_BUTTON); }
+    };
+
+    /** Cache stored in the default location */
+    static CapabilityCache* instance();
+
+    /** Cache stored in filename, an empty filename keeps it in memory */
+    explicit CapabilityCache(const std::string& filename);
+    ~CapabilityCache();
+
+    /** Capabilities of device, computed from its bitmaps on a miss */
+    Entry get(const SysfsTopology::InputDevice& device);
+
+    /** Write the cache back to disk if anything changed */
+    bool save();
+
+    void clear();
+
+    uint64_t getHits() const { return m_hits; }
+    uint64_t getMisses() const { return m_misses; }
+
+    static Key makeKey(const SysfsTopology::InputDevice& device);
+    static Entry compute(const SysfsTopology::InputDevice& device);
+
+    /** $XDG_CACHE_HOME/jstest-qt/capabilities.bin */
+    static std::string getDefaultFilename();
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return key.caps_hash ^ (uint64_t(key.vendor) << 48 | uint64_t(key.product) << 32 |
+                                    uint64_t(key.version) << 16 | key.bustype);
+        }
+    };
+
+    void load();
+
+    std::string m_filename;
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    bool m_dirty;
+    uint64_t m_hits;
+    uint64_t m_misses;
+
+    // Prohibit copying
+    CapabilityCache(const CapabilityCache&) = delete;
+    CapabilityCache& operator=(const CapabilityCache&) = delete;
+};
+
+#endif // JSTEST_QT_CAPABILITY_CACHE_H
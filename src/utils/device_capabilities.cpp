@@ -0,0 +1,115 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "utils/device_capabilities.h"
+
+#include <stdexcept>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+// String ioctls leave the buffer alone on devices that have no such
+// string, e.g. phys and uniq of most virtual devices
+static std::string read_string(int fd, unsigned long request_len0, char (&buffer)[256])
+{
+    buffer[0] = '\0';
+    if (ioctl(fd, request_len0, buffer) < 0)
+        return std::string();
+    buffer[sizeof(buffer) - 1] = '\0';
+    return buffer;
+}
+
+DeviceCapabilities::DeviceCapabilities()
+    : ev(),
+      abs(),
+      key(),
+      ff(),
+      prop(),
+      key_state(),
+      absinfo(),
+      id(),
+      name(),
+      phys(),
+      uniq()
+{
+}
+
+bool DeviceCapabilities::read(int fd)
+{
+    if (ioctl(fd, EVIOCGBIT(0, ev.bytes()), ev.data()) < 0)
+        return false;
+
+    if (ev.test(EV_ABS))
+        ioctl(fd, EVIOCGBIT(EV_ABS, abs.bytes()), abs.data());
+    if (ev.test(EV_KEY)) {
+        ioctl(fd, EVIOCGBIT(EV_KEY, key.bytes()), key.data());
+        ioctl(fd, EVIOCGKEY(key_state.bytes()), key_state.data());
+    }
+    if (ev.test(EV_FF))
+        ioctl(fd, EVIOCGBIT(EV_FF, ff.bytes()), ff.data());
+    ioctl(fd, EVIOCGPROP(prop.bytes()), prop.data());
+
+    // Only the axes the device has, the others stay zeroed
+    for (int code = 0; code < ABS_CNT; code++) {
+        if (abs.test(code))
+            ioctl(fd, EVIOCGABS(code), &absinfo[code]);
+    }
+
+    ioctl(fd, EVIOCGID, &id);
+
+    char buffer[256];
+    name = read_string(fd, EVIOCGNAME(sizeof(buffer)), buffer);
+    phys = read_string(fd, EVIOCGPHYS(sizeof(buffer)), buffer);
+    uniq = read_string(fd, EVIOCGUNIQ(sizeof(buffer)), buffer);
+
+    return true;
+}
+
+DeviceCapabilities DeviceCapabilities::probe(const std::string& devnode)
+{
+    int fd = open(devnode.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error(devnode + ": " + strerror(errno));
+    }
+
+    DeviceCapabilities caps;
+    bool ok = caps.read(fd);
+    close(fd);
+
+    if (!ok) {
+        throw std::runtime_error(devnode + ": not an evdev device");
+    }
+    return caps;
+}
+
+std::vector<int> DeviceCapabilities::getAxisCodes() const
+{
+    std::vector<int> codes;
+    abs.collect(0, ABS_CNT, codes);
+    return codes;
+}
+
+std::vector<int> DeviceCapabilities::getButtonCodes() const
+{
+    std::vector<int> codes;
+    key.collect(BTN_JOYSTICK, KEY_CNT, codes);
+    key.collect(BTN_MISC, BTN_JOYSTICK, codes);
+    return codes;
+}
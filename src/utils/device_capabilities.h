@@ -0,0 +1,77 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_DEVICE_CAPABILITIES_H
+#define JSTEST_QT_DEVICE_CAPABILITIES_H
+
+#include <string>
+#include <vector>
+#include <linux/input.h>
+
+#include "utils/input_bits.h"
+
+/**
+ * Everything there is to know about an evdev device, read with one
+ * batch of ioctls on an fd that is already open: capability bitmaps,
+ * ids, strings, the ranges and current values of all axes and the
+ * current key state. Joystick backends and probes share this, so a
+ * device node is opened once instead of once per question.
+ */
+class DeviceCapabilities
+{
+public:
+    EvBits ev;
+    AbsBits abs;
+    KeyBits key;
+    FfBits ff;
+    PropBits prop;
+
+    // Snapshot of the device state at the time of read()
+    KeyBits key_state;
+    struct input_absinfo absinfo[ABS_CNT];
+
+    struct input_id id;
+    std::string name;
+    std::string phys;
+    std::string uniq;
+
+public:
+    DeviceCapabilities();
+
+    /** Query fd, returns false if it isn't an evdev device */
+    bool read(int fd);
+
+    /** Open devnode, read() it and close it again. Throws on error. */
+    static DeviceCapabilities probe(const std::string& devnode);
+
+    bool isJoystick() const { return is_joystick_bits(ev, key); }
+    bool hasForceFeedback() const { return ev.test(EV_FF); }
+
+    /** Axis and button count the way joydev numbers them */
+    int getAxisCount() const { return abs.count(); }
+    int getButtonCount() const { return key.count(BTN_MISC, KEY_CNT); }
+
+    /** ABS codes in joydev order */
+    std::vector<int> getAxisCodes() const;
+
+    /** KEY codes in joydev order: BTN_JOYSTICK and up first, then the
+        ones between BTN_MISC and BTN_JOYSTICK */
+    std::vector<int> getButtonCodes() const;
+};
+
+#endif // JSTEST_QT_DEVICE_CAPABILITIES_H
@@ -12,6 +12,8 @@
 #include <QScreen>
 #include <QProcess>
 
+#include "../joystick_factory.h"
+
 class DialogManager : public QObject
 {
     Q_OBJECT
@@ -22,12 +24,28 @@ public:
         return instance;
     }
 
-    // Launch a dialog in a completely separate process
-    static void launchExternalDialog(const QString& type, const QString& devicePath) {
+    // Launch a dialog in a completely separate process, backend is the
+    // one the device is open with here, the child would otherwise pick
+    // its own for the platform and may not be able to open the device
+    static void launchExternalDialog(const QString& type, const QString& devicePath,
+                                     JoystickBackend backend) {
         QString program = QApplication::applicationFilePath();
         QStringList arguments;
         arguments << "--external-dialog" << type << devicePath;
         
+        switch (JoystickFactory::resolveBackend(backend)) {
+            case JoystickBackend::LIBINPUT:
+                arguments << "--libinput";
+                break;
+            case JoystickBackend::EVDEV:
+                arguments << "--evdev";
+                break;
+            case JoystickBackend::LEGACY:
+            default:
+                arguments << "--legacy";
+                break;
+        }
+        
         QProcess* process = new QProcess();
         process->setProgram(program);
         process->setArguments(arguments);
@@ -40,13 +58,13 @@ public:
     }
     
     // Helper to create mapping dialog in a separate process
-    static void showMappingDialog(const QString& devicePath) {
-        launchExternalDialog("mapping", devicePath);
+    static void showMappingDialog(const QString& devicePath, JoystickBackend backend) {
+        launchExternalDialog("mapping", devicePath, backend);
     }
     
     // Helper to create calibration dialog in a separate process
-    static void showCalibrationDialog(const QString& devicePath) {
-        launchExternalDialog("calibration", devicePath);
+    static void showCalibrationDialog(const QString& devicePath, JoystickBackend backend) {
+        launchExternalDialog("calibration", devicePath, backend);
     }
 
 private:
@@ -22,182 +22,824 @@
 #include <QKeySequence>
 #include <QGuiApplication>
 #include <linux/input.h>
-#include <iostream>
-#include <sstream>
 #include <stdexcept>
 #include <map>
+#include <stdint.h>
+#include <stdlib.h>
 
-template<class Enum>
-class EnumBox
+struct EventName
 {
-protected:
-    std::string name;
-    std::map<Enum, std::string> enum2string;
-    std::map<std::string, Enum> string2enum;
+    const char* name;
+    int type;
+    int code;
+};
 
-protected:
-    EnumBox(const std::string& name)
-        : name(name)
-    {
+// Every KEY, BTN, ABS and REL code in linux/input-event-codes.h as of
+// Linux 6.1, sorted by type and code. The values are spelled out, so
+// building against older kernel headers still knows the newer names.
+// Where a code has several names the first one is what btn2str() and
+// friends return, the others are accepted by str2event() only.
+static constexpr EventName event_names[] = {
+    { "KEY_RESERVED",              EV_KEY, 0x000 },
+    { "KEY_ESC",                   EV_KEY, 0x001 },
+    { "KEY_1",                     EV_KEY, 0x002 },
+    { "KEY_2",                     EV_KEY, 0x003 },
+    { "KEY_3",                     EV_KEY, 0x004 },
+    { "KEY_4",                     EV_KEY, 0x005 },
+    { "KEY_5",                     EV_KEY, 0x006 },
+    { "KEY_6",                     EV_KEY, 0x007 },
+    { "KEY_7",                     EV_KEY, 0x008 },
+    { "KEY_8",                     EV_KEY, 0x009 },
+    { "KEY_9",                     EV_KEY, 0x00a },
+    { "KEY_0",                     EV_KEY, 0x00b },
+    { "KEY_MINUS",                 EV_KEY, 0x00c },
+    { "KEY_EQUAL",                 EV_KEY, 0x00d },
+    { "KEY_BACKSPACE",             EV_KEY, 0x00e },
+    { "KEY_TAB",                   EV_KEY, 0x00f },
+    { "KEY_Q",                     EV_KEY, 0x010 },
+    { "KEY_W",                     EV_KEY, 0x011 },
+    { "KEY_E",                     EV_KEY, 0x012 },
+    { "KEY_R",                     EV_KEY, 0x013 },
+    { "KEY_T",                     EV_KEY, 0x014 },
+    { "KEY_Y",                     EV_KEY, 0x015 },
+    { "KEY_U",                     EV_KEY, 0x016 },
+    { "KEY_I",                     EV_KEY, 0x017 },
+    { "KEY_O",                     EV_KEY, 0x018 },
+    { "KEY_P",                     EV_KEY, 0x019 },
+    { "KEY_LEFTBRACE",             EV_KEY, 0x01a },
+    { "KEY_RIGHTBRACE",            EV_KEY, 0x01b },
+    { "KEY_ENTER",                 EV_KEY, 0x01c },
+    { "KEY_LEFTCTRL",              EV_KEY, 0x01d },
+    { "KEY_A",                     EV_KEY, 0x01e },
+    { "KEY_S",                     EV_KEY, 0x01f },
+    { "KEY_D",                     EV_KEY, 0x020 },
+    { "KEY_F",                     EV_KEY, 0x021 },
+    { "KEY_G",                     EV_KEY, 0x022 },
+    { "KEY_H",                     EV_KEY, 0x023 },
+    { "KEY_J",                     EV_KEY, 0x024 },
+    { "KEY_K",                     EV_KEY, 0x025 },
+    { "KEY_L",                     EV_KEY, 0x026 },
+    { "KEY_SEMICOLON",             EV_KEY, 0x027 },
+    { "KEY_APOSTROPHE",            EV_KEY, 0x028 },
+    { "KEY_GRAVE",                 EV_KEY, 0x029 },
+    { "KEY_LEFTSHIFT",             EV_KEY, 0x02a },
+    { "KEY_BACKSLASH",             EV_KEY, 0x02b },
+    { "KEY_Z",                     EV_KEY, 0x02c },
+    { "KEY_X",                     EV_KEY, 0x02d },
+    { "KEY_C",                     EV_KEY, 0x02e },
+    { "KEY_V",                     EV_KEY, 0x02f },
+    { "KEY_B",                     EV_KEY, 0x030 },
+    { "KEY_N",                     EV_KEY, 0x031 },
+    { "KEY_M",                     EV_KEY, 0x032 },
+    { "KEY_COMMA",                 EV_KEY, 0x033 },
+    { "KEY_DOT",                   EV_KEY, 0x034 },
+    { "KEY_SLASH",                 EV_KEY, 0x035 },
+    { "KEY_RIGHTSHIFT",            EV_KEY, 0x036 },
+    { "KEY_KPASTERISK",            EV_KEY, 0x037 },
+    { "KEY_LEFTALT",               EV_KEY, 0x038 },
+    { "KEY_SPACE",                 EV_KEY, 0x039 },
+    { "KEY_CAPSLOCK",              EV_KEY, 0x03a },
+    { "KEY_F1",                    EV_KEY, 0x03b },
+    { "KEY_F2",                    EV_KEY, 0x03c },
+    { "KEY_F3",                    EV_KEY, 0x03d },
+    { "KEY_F4",                    EV_KEY, 0x03e },
+    { "KEY_F5",                    EV_KEY, 0x03f },
+    { "KEY_F6",                    EV_KEY, 0x040 },
+    { "KEY_F7",                    EV_KEY, 0x041 },
+    { "KEY_F8",                    EV_KEY, 0x042 },
+    { "KEY_F9",                    EV_KEY, 0x043 },
+    { "KEY_F10",                   EV_KEY, 0x044 },
+    { "KEY_NUMLOCK",               EV_KEY, 0x045 },
+    { "KEY_SCROLLLOCK",            EV_KEY, 0x046 },
+    { "KEY_KP7",                   EV_KEY, 0x047 },
+    { "KEY_KP8",                   EV_KEY, 0x048 },
+    { "KEY_KP9",                   EV_KEY, 0x049 },
+    { "KEY_KPMINUS",               EV_KEY, 0x04a },
+    { "KEY_KP4",                   EV_KEY, 0x04b },
+    { "KEY_KP5",                   EV_KEY, 0x04c },
+    { "KEY_KP6",                   EV_KEY, 0x04d },
+    { "KEY_KPPLUS",                EV_KEY, 0x04e },
+    { "KEY_KP1",                   EV_KEY, 0x04f },
+    { "KEY_KP2",                   EV_KEY, 0x050 },
+    { "KEY_KP3",                   EV_KEY, 0x051 },
+    { "KEY_KP0",                   EV_KEY, 0x052 },
+    { "KEY_KPDOT",                 EV_KEY, 0x053 },
+    { "KEY_ZENKAKUHANKAKU",        EV_KEY, 0x055 },
+    { "KEY_102ND",                 EV_KEY, 0x056 },
+    { "KEY_F11",                   EV_KEY, 0x057 },
+    { "KEY_F12",                   EV_KEY, 0x058 },
+    { "KEY_RO",                    EV_KEY, 0x059 },
+    { "KEY_KATAKANA",              EV_KEY, 0x05a },
+    { "KEY_HIRAGANA",              EV_KEY, 0x05b },
+    { "KEY_HENKAN",                EV_KEY, 0x05c },
+    { "KEY_KATAKANAHIRAGANA",      EV_KEY, 0x05d },
+    { "KEY_MUHENKAN",              EV_KEY, 0x05e },
+    { "KEY_KPJPCOMMA",             EV_KEY, 0x05f },
+    { "KEY_KPENTER",               EV_KEY, 0x060 },
+    { "KEY_RIGHTCTRL",             EV_KEY, 0x061 },
+    { "KEY_KPSLASH",               EV_KEY, 0x062 },
+    { "KEY_SYSRQ",                 EV_KEY, 0x063 },
+    { "KEY_RIGHTALT",              EV_KEY, 0x064 },
+    { "KEY_LINEFEED",              EV_KEY, 0x065 },
+    { "KEY_HOME",                  EV_KEY, 0x066 },
+    { "KEY_UP",                    EV_KEY, 0x067 },
+    { "KEY_PAGEUP",                EV_KEY, 0x068 },
+    { "KEY_LEFT",                  EV_KEY, 0x069 },
+    { "KEY_RIGHT",                 EV_KEY, 0x06a },
+    { "KEY_END",                   EV_KEY, 0x06b },
+    { "KEY_DOWN",                  EV_KEY, 0x06c },
+    { "KEY_PAGEDOWN",              EV_KEY, 0x06d },
+    { "KEY_INSERT",                EV_KEY, 0x06e },
+    { "KEY_DELETE",                EV_KEY, 0x06f },
+    { "KEY_MACRO",                 EV_KEY, 0x070 },
+    { "KEY_MUTE",                  EV_KEY, 0x071 },
+    { "KEY_MIN_INTERESTING",       EV_KEY, 0x071 },
+    { "KEY_VOLUMEDOWN",            EV_KEY, 0x072 },
+    { "KEY_VOLUMEUP",              EV_KEY, 0x073 },
+    { "KEY_POWER",                 EV_KEY, 0x074 },
+    { "KEY_KPEQUAL",               EV_KEY, 0x075 },
+    { "KEY_KPPLUSMINUS",           EV_KEY, 0x076 },
+    { "KEY_PAUSE",                 EV_KEY, 0x077 },
+    { "KEY_SCALE",                 EV_KEY, 0x078 },
+    { "KEY_KPCOMMA",               EV_KEY, 0x079 },
+    { "KEY_HANGEUL",               EV_KEY, 0x07a },
+    { "KEY_HANGUEL",               EV_KEY, 0x07a },
+    { "KEY_HANJA",                 EV_KEY, 0x07b },
+    { "KEY_YEN",                   EV_KEY, 0x07c },
+    { "KEY_LEFTMETA",              EV_KEY, 0x07d },
+    { "KEY_RIGHTMETA",             EV_KEY, 0x07e },
+    { "KEY_COMPOSE",               EV_KEY, 0x07f },
+    { "KEY_STOP",                  EV_KEY, 0x080 },
+    { "KEY_AGAIN",                 EV_KEY, 0x081 },
+    { "KEY_PROPS",                 EV_KEY, 0x082 },
+    { "KEY_UNDO",                  EV_KEY, 0x083 },
+    { "KEY_FRONT",                 EV_KEY, 0x084 },
+    { "KEY_COPY",                  EV_KEY, 0x085 },
+    { "KEY_OPEN",                  EV_KEY, 0x086 },
+    { "KEY_PASTE",                 EV_KEY, 0x087 },
+    { "KEY_FIND",                  EV_KEY, 0x088 },
+    { "KEY_CUT",                   EV_KEY, 0x089 },
+    { "KEY_HELP",                  EV_KEY, 0x08a },
+    { "KEY_MENU",                  EV_KEY, 0x08b },
+    { "KEY_CALC",                  EV_KEY, 0x08c },
+    { "KEY_SETUP",                 EV_KEY, 0x08d },
+    { "KEY_SLEEP",                 EV_KEY, 0x08e },
+    { "KEY_WAKEUP",                EV_KEY, 0x08f },
+    { "KEY_FILE",                  EV_KEY, 0x090 },
+    { "KEY_SENDFILE",              EV_KEY, 0x091 },
+    { "KEY_DELETEFILE",            EV_KEY, 0x092 },
+    { "KEY_XFER",                  EV_KEY, 0x093 },
+    { "KEY_PROG1",                 EV_KEY, 0x094 },
+    { "KEY_PROG2",                 EV_KEY, 0x095 },
+    { "KEY_WWW",                   EV_KEY, 0x096 },
+    { "KEY_MSDOS",                 EV_KEY, 0x097 },
+    { "KEY_COFFEE",                EV_KEY, 0x098 },
+    { "KEY_SCREENLOCK",            EV_KEY, 0x098 },
+    { "KEY_ROTATE_DISPLAY",        EV_KEY, 0x099 },
+    { "KEY_DIRECTION",             EV_KEY, 0x099 },
+    { "KEY_CYCLEWINDOWS",          EV_KEY, 0x09a },
+    { "KEY_MAIL",                  EV_KEY, 0x09b },
+    { "KEY_BOOKMARKS",             EV_KEY, 0x09c },
+    { "KEY_COMPUTER",              EV_KEY, 0x09d },
+    { "KEY_BACK",                  EV_KEY, 0x09e },
+    { "KEY_FORWARD",               EV_KEY, 0x09f },
+    { "KEY_CLOSECD",               EV_KEY, 0x0a0 },
+    { "KEY_EJECTCD",               EV_KEY, 0x0a1 },
+    { "KEY_EJECTCLOSECD",          EV_KEY, 0x0a2 },
+    { "KEY_NEXTSONG",              EV_KEY, 0x0a3 },
+    { "KEY_PLAYPAUSE",             EV_KEY, 0x0a4 },
+    { "KEY_PREVIOUSSONG",          EV_KEY, 0x0a5 },
+    { "KEY_STOPCD",                EV_KEY, 0x0a6 },
+    { "KEY_RECORD",                EV_KEY, 0x0a7 },
+    { "KEY_REWIND",                EV_KEY, 0x0a8 },
+    { "KEY_PHONE",                 EV_KEY, 0x0a9 },
+    { "KEY_ISO",                   EV_KEY, 0x0aa },
+    { "KEY_CONFIG",                EV_KEY, 0x0ab },
+    { "KEY_HOMEPAGE",              EV_KEY, 0x0ac },
+    { "KEY_REFRESH",               EV_KEY, 0x0ad },
+    { "KEY_EXIT",                  EV_KEY, 0x0ae },
+    { "KEY_MOVE",                  EV_KEY, 0x0af },
+    { "KEY_EDIT",                  EV_KEY, 0x0b0 },
+    { "KEY_SCROLLUP",              EV_KEY, 0x0b1 },
+    { "KEY_SCROLLDOWN",            EV_KEY, 0x0b2 },
+    { "KEY_KPLEFTPAREN",           EV_KEY, 0x0b3 },
+    { "KEY_KPRIGHTPAREN",          EV_KEY, 0x0b4 },
+    { "KEY_NEW",                   EV_KEY, 0x0b5 },
+    { "KEY_REDO",                  EV_KEY, 0x0b6 },
+    { "KEY_F13",                   EV_KEY, 0x0b7 },
+    { "KEY_F14",                   EV_KEY, 0x0b8 },
+    { "KEY_F15",                   EV_KEY, 0x0b9 },
+    { "KEY_F16",                   EV_KEY, 0x0ba },
+    { "KEY_F17",                   EV_KEY, 0x0bb },
+    { "KEY_F18",                   EV_KEY, 0x0bc },
+    { "KEY_F19",                   EV_KEY, 0x0bd },
+    { "KEY_F20",                   EV_KEY, 0x0be },
+    { "KEY_F21",                   EV_KEY, 0x0bf },
+    { "KEY_F22",                   EV_KEY, 0x0c0 },
+    { "KEY_F23",                   EV_KEY, 0x0c1 },
+    { "KEY_F24",                   EV_KEY, 0x0c2 },
+    { "KEY_PLAYCD",                EV_KEY, 0x0c8 },
+    { "KEY_PAUSECD",               EV_KEY, 0x0c9 },
+    { "KEY_PROG3",                 EV_KEY, 0x0ca },
+    { "KEY_PROG4",                 EV_KEY, 0x0cb },
+    { "KEY_ALL_APPLICATIONS",      EV_KEY, 0x0cc },
+    { "KEY_DASHBOARD",             EV_KEY, 0x0cc },
+    { "KEY_SUSPEND",               EV_KEY, 0x0cd },
+    { "KEY_CLOSE",                 EV_KEY, 0x0ce },
+    { "KEY_PLAY",                  EV_KEY, 0x0cf },
+    { "KEY_FASTFORWARD",           EV_KEY, 0x0d0 },
+    { "KEY_BASSBOOST",             EV_KEY, 0x0d1 },
+    { "KEY_PRINT",                 EV_KEY, 0x0d2 },
+    { "KEY_HP",                    EV_KEY, 0x0d3 },
+    { "KEY_CAMERA",                EV_KEY, 0x0d4 },
+    { "KEY_SOUND",                 EV_KEY, 0x0d5 },
+    { "KEY_QUESTION",              EV_KEY, 0x0d6 },
+    { "KEY_EMAIL",                 EV_KEY, 0x0d7 },
+    { "KEY_CHAT",                  EV_KEY, 0x0d8 },
+    { "KEY_SEARCH",                EV_KEY, 0x0d9 },
+    { "KEY_CONNECT",               EV_KEY, 0x0da },
+    { "KEY_FINANCE",               EV_KEY, 0x0db },
+    { "KEY_SPORT",                 EV_KEY, 0x0dc },
+    { "KEY_SHOP",                  EV_KEY, 0x0dd },
+    { "KEY_ALTERASE",              EV_KEY, 0x0de },
+    { "KEY_CANCEL",                EV_KEY, 0x0df },
+    { "KEY_BRIGHTNESSDOWN",        EV_KEY, 0x0e0 },
+    { "KEY_BRIGHTNESSUP",          EV_KEY, 0x0e1 },
+    { "KEY_MEDIA",                 EV_KEY, 0x0e2 },
+    { "KEY_SWITCHVIDEOMODE",       EV_KEY, 0x0e3 },
+    { "KEY_KBDILLUMTOGGLE",        EV_KEY, 0x0e4 },
+    { "KEY_KBDILLUMDOWN",          EV_KEY, 0x0e5 },
+    { "KEY_KBDILLUMUP",            EV_KEY, 0x0e6 },
+    { "KEY_SEND",                  EV_KEY, 0x0e7 },
+    { "KEY_REPLY",                 EV_KEY, 0x0e8 },
+    { "KEY_FORWARDMAIL",           EV_KEY, 0x0e9 },
+    { "KEY_SAVE",                  EV_KEY, 0x0ea },
+    { "KEY_DOCUMENTS",             EV_KEY, 0x0eb },
+    { "KEY_BATTERY",               EV_KEY, 0x0ec },
+    { "KEY_BLUETOOTH",             EV_KEY, 0x0ed },
+    { "KEY_WLAN",                  EV_KEY, 0x0ee },
+    { "KEY_UWB",                   EV_KEY, 0x0ef },
+    { "KEY_UNKNOWN",               EV_KEY, 0x0f0 },
+    { "KEY_VIDEO_NEXT",            EV_KEY, 0x0f1 },
+    { "KEY_VIDEO_PREV",            EV_KEY, 0x0f2 },
+    { "KEY_BRIGHTNESS_CYCLE",      EV_KEY, 0x0f3 },
+    { "KEY_BRIGHTNESS_AUTO",       EV_KEY, 0x0f4 },
+    { "KEY_BRIGHTNESS_ZERO",       EV_KEY, 0x0f4 },
+    { "KEY_DISPLAY_OFF",           EV_KEY, 0x0f5 },
+    { "KEY_WWAN",                  EV_KEY, 0x0f6 },
+    { "KEY_WIMAX",                 EV_KEY, 0x0f6 },
+    { "KEY_RFKILL",                EV_KEY, 0x0f7 },
+    { "KEY_MICMUTE",               EV_KEY, 0x0f8 },
+    { "BTN_0",                     EV_KEY, 0x100 },
+    { "BTN_MISC",                  EV_KEY, 0x100 },
+    { "BTN_1",                     EV_KEY, 0x101 },
+    { "BTN_2",                     EV_KEY, 0x102 },
+    { "BTN_3",                     EV_KEY, 0x103 },
+    { "BTN_4",                     EV_KEY, 0x104 },
+    { "BTN_5",                     EV_KEY, 0x105 },
+    { "BTN_6",                     EV_KEY, 0x106 },
+    { "BTN_7",                     EV_KEY, 0x107 },
+    { "BTN_8",                     EV_KEY, 0x108 },
+    { "BTN_9",                     EV_KEY, 0x109 },
+    { "BTN_LEFT",                  EV_KEY, 0x110 },
+    { "BTN_MOUSE",                 EV_KEY, 0x110 },
+    { "BTN_RIGHT",                 EV_KEY, 0x111 },
+    { "BTN_MIDDLE",                EV_KEY, 0x112 },
+    { "BTN_SIDE",                  EV_KEY, 0x113 },
+    { "BTN_EXTRA",                 EV_KEY, 0x114 },
+    { "BTN_FORWARD",               EV_KEY, 0x115 },
+    { "BTN_BACK",                  EV_KEY, 0x116 },
+    { "BTN_TASK",                  EV_KEY, 0x117 },
+    { "BTN_TRIGGER",               EV_KEY, 0x120 },
+    { "BTN_JOYSTICK",              EV_KEY, 0x120 },
+    { "BTN_THUMB",                 EV_KEY, 0x121 },
+    { "BTN_THUMB2",                EV_KEY, 0x122 },
+    { "BTN_TOP",                   EV_KEY, 0x123 },
+    { "BTN_TOP2",                  EV_KEY, 0x124 },
+    { "BTN_PINKIE",                EV_KEY, 0x125 },
+    { "BTN_BASE",                  EV_KEY, 0x126 },
+    { "BTN_BASE2",                 EV_KEY, 0x127 },
+    { "BTN_BASE3",                 EV_KEY, 0x128 },
+    { "BTN_BASE4",                 EV_KEY, 0x129 },
+    { "BTN_BASE5",                 EV_KEY, 0x12a },
+    { "BTN_BASE6",                 EV_KEY, 0x12b },
+    { "BTN_DEAD",                  EV_KEY, 0x12f },
+    { "BTN_A",                     EV_KEY, 0x130 },
+    { "BTN_SOUTH",                 EV_KEY, 0x130 },
+    { "BTN_GAMEPAD",               EV_KEY, 0x130 },
+    { "BTN_B",                     EV_KEY, 0x131 },
+    { "BTN_EAST",                  EV_KEY, 0x131 },
+    { "BTN_C",                     EV_KEY, 0x132 },
+    { "BTN_X",                     EV_KEY, 0x133 },
+    { "BTN_NORTH",                 EV_KEY, 0x133 },
+    { "BTN_Y",                     EV_KEY, 0x134 },
+    { "BTN_WEST",                  EV_KEY, 0x134 },
+    { "BTN_Z",                     EV_KEY, 0x135 },
+    { "BTN_TL",                    EV_KEY, 0x136 },
+    { "BTN_TR",                    EV_KEY, 0x137 },
+    { "BTN_TL2",                   EV_KEY, 0x138 },
+    { "BTN_TR2",                   EV_KEY, 0x139 },
+    { "BTN_SELECT",                EV_KEY, 0x13a },
+    { "BTN_START",                 EV_KEY, 0x13b },
+    { "BTN_MODE",                  EV_KEY, 0x13c },
+    { "BTN_THUMBL",                EV_KEY, 0x13d },
+    { "BTN_THUMBR",                EV_KEY, 0x13e },
+    { "BTN_TOOL_PEN",              EV_KEY, 0x140 },
+    { "BTN_DIGI",                  EV_KEY, 0x140 },
+    { "BTN_TOOL_RUBBER",           EV_KEY, 0x141 },
+    { "BTN_TOOL_BRUSH",            EV_KEY, 0x142 },
+    { "BTN_TOOL_PENCIL",           EV_KEY, 0x143 },
+    { "BTN_TOOL_AIRBRUSH",         EV_KEY, 0x144 },
+    { "BTN_TOOL_FINGER",           EV_KEY, 0x145 },
+    { "BTN_TOOL_MOUSE",            EV_KEY, 0x146 },
+    { "BTN_TOOL_LENS",             EV_KEY, 0x147 },
+    { "BTN_TOOL_QUINTTAP",         EV_KEY, 0x148 },
+    { "BTN_STYLUS3",               EV_KEY, 0x149 },
+    { "BTN_TOUCH",                 EV_KEY, 0x14a },
+    { "BTN_STYLUS",                EV_KEY, 0x14b },
+    { "BTN_STYLUS2",               EV_KEY, 0x14c },
+    { "BTN_TOOL_DOUBLETAP",        EV_KEY, 0x14d },
+    { "BTN_TOOL_TRIPLETAP",        EV_KEY, 0x14e },
+    { "BTN_TOOL_QUADTAP",          EV_KEY, 0x14f },
+    { "BTN_GEAR_DOWN",             EV_KEY, 0x150 },
+    { "BTN_WHEEL",                 EV_KEY, 0x150 },
+    { "BTN_GEAR_UP",               EV_KEY, 0x151 },
+    { "KEY_OK",                    EV_KEY, 0x160 },
+    { "KEY_SELECT",                EV_KEY, 0x161 },
+    { "KEY_GOTO",                  EV_KEY, 0x162 },
+    { "KEY_CLEAR",                 EV_KEY, 0x163 },
+    { "KEY_POWER2",                EV_KEY, 0x164 },
+    { "KEY_OPTION",                EV_KEY, 0x165 },
+    { "KEY_INFO",                  EV_KEY, 0x166 },
+    { "KEY_TIME",                  EV_KEY, 0x167 },
+    { "KEY_VENDOR",                EV_KEY, 0x168 },
+    { "KEY_ARCHIVE",               EV_KEY, 0x169 },
+    { "KEY_PROGRAM",               EV_KEY, 0x16a },
+    { "KEY_CHANNEL",               EV_KEY, 0x16b },
+    { "KEY_FAVORITES",             EV_KEY, 0x16c },
+    { "KEY_EPG",                   EV_KEY, 0x16d },
+    { "KEY_PVR",                   EV_KEY, 0x16e },
+    { "KEY_MHP",                   EV_KEY, 0x16f },
+    { "KEY_LANGUAGE",              EV_KEY, 0x170 },
+    { "KEY_TITLE",                 EV_KEY, 0x171 },
+    { "KEY_SUBTITLE",              EV_KEY, 0x172 },
+    { "KEY_ANGLE",                 EV_KEY, 0x173 },
+    { "KEY_FULL_SCREEN",           EV_KEY, 0x174 },
+    { "KEY_ZOOM",                  EV_KEY, 0x174 },
+    { "KEY_MODE",                  EV_KEY, 0x175 },
+    { "KEY_KEYBOARD",              EV_KEY, 0x176 },
+    { "KEY_ASPECT_RATIO",          EV_KEY, 0x177 },
+    { "KEY_SCREEN",                EV_KEY, 0x177 },
+    { "KEY_PC",                    EV_KEY, 0x178 },
+    { "KEY_TV",                    EV_KEY, 0x179 },
+    { "KEY_TV2",                   EV_KEY, 0x17a },
+    { "KEY_VCR",                   EV_KEY, 0x17b },
+    { "KEY_VCR2",                  EV_KEY, 0x17c },
+    { "KEY_SAT",                   EV_KEY, 0x17d },
+    { "KEY_SAT2",                  EV_KEY, 0x17e },
+    { "KEY_CD",                    EV_KEY, 0x17f },
+    { "KEY_TAPE",                  EV_KEY, 0x180 },
+    { "KEY_RADIO",                 EV_KEY, 0x181 },
+    { "KEY_TUNER",                 EV_KEY, 0x182 },
+    { "KEY_PLAYER",                EV_KEY, 0x183 },
+    { "KEY_TEXT",                  EV_KEY, 0x184 },
+    { "KEY_DVD",                   EV_KEY, 0x185 },
+    { "KEY_AUX",                   EV_KEY, 0x186 },
+    { "KEY_MP3",                   EV_KEY, 0x187 },
+    { "KEY_AUDIO",                 EV_KEY, 0x188 },
+    { "KEY_VIDEO",                 EV_KEY, 0x189 },
+    { "KEY_DIRECTORY",             EV_KEY, 0x18a },
+    { "KEY_LIST",                  EV_KEY, 0x18b },
+    { "KEY_MEMO",                  EV_KEY, 0x18c },
+    { "KEY_CALENDAR",              EV_KEY, 0x18d },
+    { "KEY_RED",                   EV_KEY, 0x18e },
+    { "KEY_GREEN",                 EV_KEY, 0x18f },
+    { "KEY_YELLOW",                EV_KEY, 0x190 },
+    { "KEY_BLUE",                  EV_KEY, 0x191 },
+    { "KEY_CHANNELUP",             EV_KEY, 0x192 },
+    { "KEY_CHANNELDOWN",           EV_KEY, 0x193 },
+    { "KEY_FIRST",                 EV_KEY, 0x194 },
+    { "KEY_LAST",                  EV_KEY, 0x195 },
+    { "KEY_AB",                    EV_KEY, 0x196 },
+    { "KEY_NEXT",                  EV_KEY, 0x197 },
+    { "KEY_RESTART",               EV_KEY, 0x198 },
+    { "KEY_SLOW",                  EV_KEY, 0x199 },
+    { "KEY_SHUFFLE",               EV_KEY, 0x19a },
+    { "KEY_BREAK",                 EV_KEY, 0x19b },
+    { "KEY_PREVIOUS",              EV_KEY, 0x19c },
+    { "KEY_DIGITS",                EV_KEY, 0x19d },
+    { "KEY_TEEN",                  EV_KEY, 0x19e },
+    { "KEY_TWEN",                  EV_KEY, 0x19f },
+    { "KEY_VIDEOPHONE",            EV_KEY, 0x1a0 },
+    { "KEY_GAMES",                 EV_KEY, 0x1a1 },
+    { "KEY_ZOOMIN",                EV_KEY, 0x1a2 },
+    { "KEY_ZOOMOUT",               EV_KEY, 0x1a3 },
+    { "KEY_ZOOMRESET",             EV_KEY, 0x1a4 },
+    { "KEY_WORDPROCESSOR",         EV_KEY, 0x1a5 },
+    { "KEY_EDITOR",                EV_KEY, 0x1a6 },
+    { "KEY_SPREADSHEET",           EV_KEY, 0x1a7 },
+    { "KEY_GRAPHICSEDITOR",        EV_KEY, 0x1a8 },
+    { "KEY_PRESENTATION",          EV_KEY, 0x1a9 },
+    { "KEY_DATABASE",              EV_KEY, 0x1aa },
+    { "KEY_NEWS",                  EV_KEY, 0x1ab },
+    { "KEY_VOICEMAIL",             EV_KEY, 0x1ac },
+    { "KEY_ADDRESSBOOK",           EV_KEY, 0x1ad },
+    { "KEY_MESSENGER",             EV_KEY, 0x1ae },
+    { "KEY_DISPLAYTOGGLE",         EV_KEY, 0x1af },
+    { "KEY_BRIGHTNESS_TOGGLE",     EV_KEY, 0x1af },
+    { "KEY_SPELLCHECK",            EV_KEY, 0x1b0 },
+    { "KEY_LOGOFF",                EV_KEY, 0x1b1 },
+    { "KEY_DOLLAR",                EV_KEY, 0x1b2 },
+    { "KEY_EURO",                  EV_KEY, 0x1b3 },
+    { "KEY_FRAMEBACK",             EV_KEY, 0x1b4 },
+    { "KEY_FRAMEFORWARD",          EV_KEY, 0x1b5 },
+    { "KEY_CONTEXT_MENU",          EV_KEY, 0x1b6 },
+    { "KEY_MEDIA_REPEAT",          EV_KEY, 0x1b7 },
+    { "KEY_10CHANNELSUP",          EV_KEY, 0x1b8 },
+    { "KEY_10CHANNELSDOWN",        EV_KEY, 0x1b9 },
+    { "KEY_IMAGES",                EV_KEY, 0x1ba },
+    { "KEY_NOTIFICATION_CENTER",   EV_KEY, 0x1bc },
+    { "KEY_PICKUP_PHONE",          EV_KEY, 0x1bd },
+    { "KEY_HANGUP_PHONE",          EV_KEY, 0x1be },
+    { "KEY_LINK_PHONE",            EV_KEY, 0x1bf },
+    { "KEY_DEL_EOL",               EV_KEY, 0x1c0 },
+    { "KEY_DEL_EOS",               EV_KEY, 0x1c1 },
+    { "KEY_INS_LINE",              EV_KEY, 0x1c2 },
+    { "KEY_DEL_LINE",              EV_KEY, 0x1c3 },
+    { "KEY_FN",                    EV_KEY, 0x1d0 },
+    { "KEY_FN_ESC",                EV_KEY, 0x1d1 },
+    { "KEY_FN_F1",                 EV_KEY, 0x1d2 },
+    { "KEY_FN_F2",                 EV_KEY, 0x1d3 },
+    { "KEY_FN_F3",                 EV_KEY, 0x1d4 },
+    { "KEY_FN_F4",                 EV_KEY, 0x1d5 },
+    { "KEY_FN_F5",                 EV_KEY, 0x1d6 },
+    { "KEY_FN_F6",                 EV_KEY, 0x1d7 },
+    { "KEY_FN_F7",                 EV_KEY, 0x1d8 },
+    { "KEY_FN_F8",                 EV_KEY, 0x1d9 },
+    { "KEY_FN_F9",                 EV_KEY, 0x1da },
+    { "KEY_FN_F10",                EV_KEY, 0x1db },
+    { "KEY_FN_F11",                EV_KEY, 0x1dc },
+    { "KEY_FN_F12",                EV_KEY, 0x1dd },
+    { "KEY_FN_1",                  EV_KEY, 0x1de },
+    { "KEY_FN_2",                  EV_KEY, 0x1df },
+    { "KEY_FN_D",                  EV_KEY, 0x1e0 },
+    { "KEY_FN_E",                  EV_KEY, 0x1e1 },
+    { "KEY_FN_F",                  EV_KEY, 0x1e2 },
+    { "KEY_FN_S",                  EV_KEY, 0x1e3 },
+    { "KEY_FN_B",                  EV_KEY, 0x1e4 },
+    { "KEY_FN_RIGHT_SHIFT",        EV_KEY, 0x1e5 },
+    { "KEY_BRL_DOT1",              EV_KEY, 0x1f1 },
+    { "KEY_BRL_DOT2",              EV_KEY, 0x1f2 },
+    { "KEY_BRL_DOT3",              EV_KEY, 0x1f3 },
+    { "KEY_BRL_DOT4",              EV_KEY, 0x1f4 },
+    { "KEY_BRL_DOT5",              EV_KEY, 0x1f5 },
+    { "KEY_BRL_DOT6",              EV_KEY, 0x1f6 },
+    { "KEY_BRL_DOT7",              EV_KEY, 0x1f7 },
+    { "KEY_BRL_DOT8",              EV_KEY, 0x1f8 },
+    { "KEY_BRL_DOT9",              EV_KEY, 0x1f9 },
+    { "KEY_BRL_DOT10",             EV_KEY, 0x1fa },
+    { "KEY_NUMERIC_0",             EV_KEY, 0x200 },
+    { "KEY_NUMERIC_1",             EV_KEY, 0x201 },
+    { "KEY_NUMERIC_2",             EV_KEY, 0x202 },
+    { "KEY_NUMERIC_3",             EV_KEY, 0x203 },
+    { "KEY_NUMERIC_4",             EV_KEY, 0x204 },
+    { "KEY_NUMERIC_5",             EV_KEY, 0x205 },
+    { "KEY_NUMERIC_6",             EV_KEY, 0x206 },
+    { "KEY_NUMERIC_7",             EV_KEY, 0x207 },
+    { "KEY_NUMERIC_8",             EV_KEY, 0x208 },
+    { "KEY_NUMERIC_9",             EV_KEY, 0x209 },
+    { "KEY_NUMERIC_STAR",          EV_KEY, 0x20a },
+    { "KEY_NUMERIC_POUND",         EV_KEY, 0x20b },
+    { "KEY_NUMERIC_A",             EV_KEY, 0x20c },
+    { "KEY_NUMERIC_B",             EV_KEY, 0x20d },
+    { "KEY_NUMERIC_C",             EV_KEY, 0x20e },
+    { "KEY_NUMERIC_D",             EV_KEY, 0x20f },
+    { "KEY_CAMERA_FOCUS",          EV_KEY, 0x210 },
+    { "KEY_WPS_BUTTON",            EV_KEY, 0x211 },
+    { "KEY_TOUCHPAD_TOGGLE",       EV_KEY, 0x212 },
+    { "KEY_TOUCHPAD_ON",           EV_KEY, 0x213 },
+    { "KEY_TOUCHPAD_OFF",          EV_KEY, 0x214 },
+    { "KEY_CAMERA_ZOOMIN",         EV_KEY, 0x215 },
+    { "KEY_CAMERA_ZOOMOUT",        EV_KEY, 0x216 },
+    { "KEY_CAMERA_UP",             EV_KEY, 0x217 },
+    { "KEY_CAMERA_DOWN",           EV_KEY, 0x218 },
+    { "KEY_CAMERA_LEFT",           EV_KEY, 0x219 },
+    { "KEY_CAMERA_RIGHT",          EV_KEY, 0x21a },
+    { "KEY_ATTENDANT_ON",          EV_KEY, 0x21b },
+    { "KEY_ATTENDANT_OFF",         EV_KEY, 0x21c },
+    { "KEY_ATTENDANT_TOGGLE",      EV_KEY, 0x21d },
+    { "KEY_LIGHTS_TOGGLE",         EV_KEY, 0x21e },
+    { "BTN_DPAD_UP",               EV_KEY, 0x220 },
+    { "BTN_DPAD_DOWN",             EV_KEY, 0x221 },
+    { "BTN_DPAD_LEFT",             EV_KEY, 0x222 },
+    { "BTN_DPAD_RIGHT",            EV_KEY, 0x223 },
+    { "KEY_ALS_TOGGLE",            EV_KEY, 0x230 },
+    { "KEY_ROTATE_LOCK_TOGGLE",    EV_KEY, 0x231 },
+    { "KEY_REFRESH_RATE_TOGGLE",   EV_KEY, 0x232 },
+    { "KEY_BUTTONCONFIG",          EV_KEY, 0x240 },
+    { "KEY_TASKMANAGER",           EV_KEY, 0x241 },
+    { "KEY_JOURNAL",               EV_KEY, 0x242 },
+    { "KEY_CONTROLPANEL",          EV_KEY, 0x243 },
+    { "KEY_APPSELECT",             EV_KEY, 0x244 },
+    { "KEY_SCREENSAVER",           EV_KEY, 0x245 },
+    { "KEY_VOICECOMMAND",          EV_KEY, 0x246 },
+    { "KEY_ASSISTANT",             EV_KEY, 0x247 },
+    { "KEY_KBD_LAYOUT_NEXT",       EV_KEY, 0x248 },
+    { "KEY_EMOJI_PICKER",          EV_KEY, 0x249 },
+    { "KEY_DICTATE",               EV_KEY, 0x24a },
+    { "KEY_BRIGHTNESS_MIN",        EV_KEY, 0x250 },
+    { "KEY_KBDINPUTASSIST_PREV",   EV_KEY, 0x260 },
+    { "KEY_KBDINPUTASSIST_NEXT",   EV_KEY, 0x261 },
+    { "KEY_KBDINPUTASSIST_PREVGROUP", EV_KEY, 0x262 },
+    { "KEY_KBDINPUTASSIST_NEXTGROUP", EV_KEY, 0x263 },
+    { "KEY_KBDINPUTASSIST_ACCEPT", EV_KEY, 0x264 },
+    { "KEY_KBDINPUTASSIST_CANCEL", EV_KEY, 0x265 },
+    { "KEY_RIGHT_UP",              EV_KEY, 0x266 },
+    { "KEY_RIGHT_DOWN",            EV_KEY, 0x267 },
+    { "KEY_LEFT_UP",               EV_KEY, 0x268 },
+    { "KEY_LEFT_DOWN",             EV_KEY, 0x269 },
+    { "KEY_ROOT_MENU",             EV_KEY, 0x26a },
+    { "KEY_MEDIA_TOP_MENU",        EV_KEY, 0x26b },
+    { "KEY_NUMERIC_11",            EV_KEY, 0x26c },
+    { "KEY_NUMERIC_12",            EV_KEY, 0x26d },
+    { "KEY_AUDIO_DESC",            EV_KEY, 0x26e },
+    { "KEY_3D_MODE",               EV_KEY, 0x26f },
+    { "KEY_NEXT_FAVORITE",         EV_KEY, 0x270 },
+    { "KEY_STOP_RECORD",           EV_KEY, 0x271 },
+    { "KEY_PAUSE_RECORD",          EV_KEY, 0x272 },
+    { "KEY_VOD",                   EV_KEY, 0x273 },
+    { "KEY_UNMUTE",                EV_KEY, 0x274 },
+    { "KEY_FASTREVERSE",           EV_KEY, 0x275 },
+    { "KEY_SLOWREVERSE",           EV_KEY, 0x276 },
+    { "KEY_DATA",                  EV_KEY, 0x277 },
+    { "KEY_ONSCREEN_KEYBOARD",     EV_KEY, 0x278 },
+    { "KEY_PRIVACY_SCREEN_TOGGLE", EV_KEY, 0x279 },
+    { "KEY_SELECTIVE_SCREENSHOT",  EV_KEY, 0x27a },
+    { "KEY_NEXT_ELEMENT",          EV_KEY, 0x27b },
+    { "KEY_PREVIOUS_ELEMENT",      EV_KEY, 0x27c },
+    { "KEY_AUTOPILOT_ENGAGE_TOGGLE", EV_KEY, 0x27d },
+    { "KEY_MARK_WAYPOINT",         EV_KEY, 0x27e },
+    { "KEY_SOS",                   EV_KEY, 0x27f },
+    { "KEY_NAV_CHART",             EV_KEY, 0x280 },
+    { "KEY_FISHING_CHART",         EV_KEY, 0x281 },
+    { "KEY_SINGLE_RANGE_RADAR",    EV_KEY, 0x282 },
+    { "KEY_DUAL_RANGE_RADAR",      EV_KEY, 0x283 },
+    { "KEY_RADAR_OVERLAY",         EV_KEY, 0x284 },
+    { "KEY_TRADITIONAL_SONAR",     EV_KEY, 0x285 },
+    { "KEY_CLEARVU_SONAR",         EV_KEY, 0x286 },
+    { "KEY_SIDEVU_SONAR",          EV_KEY, 0x287 },
+    { "KEY_NAV_INFO",              EV_KEY, 0x288 },
+    { "KEY_BRIGHTNESS_MENU",       EV_KEY, 0x289 },
+    { "KEY_MACRO1",                EV_KEY, 0x290 },
+    { "KEY_MACRO2",                EV_KEY, 0x291 },
+    { "KEY_MACRO3",                EV_KEY, 0x292 },
+    { "KEY_MACRO4",                EV_KEY, 0x293 },
+    { "KEY_MACRO5",                EV_KEY, 0x294 },
+    { "KEY_MACRO6",                EV_KEY, 0x295 },
+    { "KEY_MACRO7",                EV_KEY, 0x296 },
+    { "KEY_MACRO8",                EV_KEY, 0x297 },
+    { "KEY_MACRO9",                EV_KEY, 0x298 },
+    { "KEY_MACRO10",               EV_KEY, 0x299 },
+    { "KEY_MACRO11",               EV_KEY, 0x29a },
+    { "KEY_MACRO12",               EV_KEY, 0x29b },
+    { "KEY_MACRO13",               EV_KEY, 0x29c },
+    { "KEY_MACRO14",               EV_KEY, 0x29d },
+    { "KEY_MACRO15",               EV_KEY, 0x29e },
+    { "KEY_MACRO16",               EV_KEY, 0x29f },
+    { "KEY_MACRO17",               EV_KEY, 0x2a0 },
+    { "KEY_MACRO18",               EV_KEY, 0x2a1 },
+    { "KEY_MACRO19",               EV_KEY, 0x2a2 },
+    { "KEY_MACRO20",               EV_KEY, 0x2a3 },
+    { "KEY_MACRO21",               EV_KEY, 0x2a4 },
+    { "KEY_MACRO22",               EV_KEY, 0x2a5 },
+    { "KEY_MACRO23",               EV_KEY, 0x2a6 },
+    { "KEY_MACRO24",               EV_KEY, 0x2a7 },
+    { "KEY_MACRO25",               EV_KEY, 0x2a8 },
+    { "KEY_MACRO26",               EV_KEY, 0x2a9 },
+    { "KEY_MACRO27",               EV_KEY, 0x2aa },
+    { "KEY_MACRO28",               EV_KEY, 0x2ab },
+    { "KEY_MACRO29",               EV_KEY, 0x2ac },
+    { "KEY_MACRO30",               EV_KEY, 0x2ad },
+    { "KEY_MACRO_RECORD_START",    EV_KEY, 0x2b0 },
+    { "KEY_MACRO_RECORD_STOP",     EV_KEY, 0x2b1 },
+    { "KEY_MACRO_PRESET_CYCLE",    EV_KEY, 0x2b2 },
+    { "KEY_MACRO_PRESET1",         EV_KEY, 0x2b3 },
+    { "KEY_MACRO_PRESET2",         EV_KEY, 0x2b4 },
+    { "KEY_MACRO_PRESET3",         EV_KEY, 0x2b5 },
+    { "KEY_KBD_LCD_MENU1",         EV_KEY, 0x2b8 },
+    { "KEY_KBD_LCD_MENU2",         EV_KEY, 0x2b9 },
+    { "KEY_KBD_LCD_MENU3",         EV_KEY, 0x2ba },
+    { "KEY_KBD_LCD_MENU4",         EV_KEY, 0x2bb },
+    { "KEY_KBD_LCD_MENU5",         EV_KEY, 0x2bc },
+    { "BTN_TRIGGER_HAPPY1",        EV_KEY, 0x2c0 },
+    { "BTN_TRIGGER_HAPPY",         EV_KEY, 0x2c0 },
+    { "BTN_TRIGGER_HAPPY2",        EV_KEY, 0x2c1 },
+    { "BTN_TRIGGER_HAPPY3",        EV_KEY, 0x2c2 },
+    { "BTN_TRIGGER_HAPPY4",        EV_KEY, 0x2c3 },
+    { "BTN_TRIGGER_HAPPY5",        EV_KEY, 0x2c4 },
+    { "BTN_TRIGGER_HAPPY6",        EV_KEY, 0x2c5 },
+    { "BTN_TRIGGER_HAPPY7",        EV_KEY, 0x2c6 },
+    { "BTN_TRIGGER_HAPPY8",        EV_KEY, 0x2c7 },
+    { "BTN_TRIGGER_HAPPY9",        EV_KEY, 0x2c8 },
+    { "BTN_TRIGGER_HAPPY10",       EV_KEY, 0x2c9 },
+    { "BTN_TRIGGER_HAPPY11",       EV_KEY, 0x2ca },
+    { "BTN_TRIGGER_HAPPY12",       EV_KEY, 0x2cb },
+    { "BTN_TRIGGER_HAPPY13",       EV_KEY, 0x2cc },
+    { "BTN_TRIGGER_HAPPY14",       EV_KEY, 0x2cd },
+    { "BTN_TRIGGER_HAPPY15",       EV_KEY, 0x2ce },
+    { "BTN_TRIGGER_HAPPY16",       EV_KEY, 0x2cf },
+    { "BTN_TRIGGER_HAPPY17",       EV_KEY, 0x2d0 },
+    { "BTN_TRIGGER_HAPPY18",       EV_KEY, 0x2d1 },
+    { "BTN_TRIGGER_HAPPY19",       EV_KEY, 0x2d2 },
+    { "BTN_TRIGGER_HAPPY20",       EV_KEY, 0x2d3 },
+    { "BTN_TRIGGER_HAPPY21",       EV_KEY, 0x2d4 },
+    { "BTN_TRIGGER_HAPPY22",       EV_KEY, 0x2d5 },
+    { "BTN_TRIGGER_HAPPY23",       EV_KEY, 0x2d6 },
+    { "BTN_TRIGGER_HAPPY24",       EV_KEY, 0x2d7 },
+    { "BTN_TRIGGER_HAPPY25",       EV_KEY, 0x2d8 },
+    { "BTN_TRIGGER_HAPPY26",       EV_KEY, 0x2d9 },
+    { "BTN_TRIGGER_HAPPY27",       EV_KEY, 0x2da },
+    { "BTN_TRIGGER_HAPPY28",       EV_KEY, 0x2db },
+    { "BTN_TRIGGER_HAPPY29",       EV_KEY, 0x2dc },
+    { "BTN_TRIGGER_HAPPY30",       EV_KEY, 0x2dd },
+    { "BTN_TRIGGER_HAPPY31",       EV_KEY, 0x2de },
+    { "BTN_TRIGGER_HAPPY32",       EV_KEY, 0x2df },
+    { "BTN_TRIGGER_HAPPY33",       EV_KEY, 0x2e0 },
+    { "BTN_TRIGGER_HAPPY34",       EV_KEY, 0x2e1 },
+    { "BTN_TRIGGER_HAPPY35",       EV_KEY, 0x2e2 },
+    { "BTN_TRIGGER_HAPPY36",       EV_KEY, 0x2e3 },
+    { "BTN_TRIGGER_HAPPY37",       EV_KEY, 0x2e4 },
+    { "BTN_TRIGGER_HAPPY38",       EV_KEY, 0x2e5 },
+    { "BTN_TRIGGER_HAPPY39",       EV_KEY, 0x2e6 },
+    { "BTN_TRIGGER_HAPPY40",       EV_KEY, 0x2e7 },
+
+    { "ABS_X",                     EV_ABS, 0x000 },
+    { "ABS_Y",                     EV_ABS, 0x001 },
+    { "ABS_Z",                     EV_ABS, 0x002 },
+    { "ABS_RX",                    EV_ABS, 0x003 },
+    { "ABS_RY",                    EV_ABS, 0x004 },
+    { "ABS_RZ",                    EV_ABS, 0x005 },
+    { "ABS_THROTTLE",              EV_ABS, 0x006 },
+    { "ABS_RUDDER",                EV_ABS, 0x007 },
+    { "ABS_WHEEL",                 EV_ABS, 0x008 },
+    { "ABS_GAS",                   EV_ABS, 0x009 },
+    { "ABS_BRAKE",                 EV_ABS, 0x00a },
+    { "ABS_HAT0X",                 EV_ABS, 0x010 },
+    { "ABS_HAT0Y",                 EV_ABS, 0x011 },
+    { "ABS_HAT1X",                 EV_ABS, 0x012 },
+    { "ABS_HAT1Y",                 EV_ABS, 0x013 },
+    { "ABS_HAT2X",                 EV_ABS, 0x014 },
+    { "ABS_HAT2Y",                 EV_ABS, 0x015 },
+    { "ABS_HAT3X",                 EV_ABS, 0x016 },
+    { "ABS_HAT3Y",                 EV_ABS, 0x017 },
+    { "ABS_PRESSURE",              EV_ABS, 0x018 },
+    { "ABS_DISTANCE",              EV_ABS, 0x019 },
+    { "ABS_TILT_X",                EV_ABS, 0x01a },
+    { "ABS_TILT_Y",                EV_ABS, 0x01b },
+    { "ABS_TOOL_WIDTH",            EV_ABS, 0x01c },
+    { "ABS_VOLUME",                EV_ABS, 0x020 },
+    { "ABS_PROFILE",               EV_ABS, 0x021 },
+    { "ABS_MISC",                  EV_ABS, 0x028 },
+    { "ABS_RESERVED",              EV_ABS, 0x02e },
+    { "ABS_MT_SLOT",               EV_ABS, 0x02f },
+    { "ABS_MT_TOUCH_MAJOR",        EV_ABS, 0x030 },
+    { "ABS_MT_TOUCH_MINOR",        EV_ABS, 0x031 },
+    { "ABS_MT_WIDTH_MAJOR",        EV_ABS, 0x032 },
+    { "ABS_MT_WIDTH_MINOR",        EV_ABS, 0x033 },
+    { "ABS_MT_ORIENTATION",        EV_ABS, 0x034 },
+    { "ABS_MT_POSITION_X",         EV_ABS, 0x035 },
+    { "ABS_MT_POSITION_Y",         EV_ABS, 0x036 },
+    { "ABS_MT_TOOL_TYPE",          EV_ABS, 0x037 },
+    { "ABS_MT_BLOB_ID",            EV_ABS, 0x038 },
+    { "ABS_MT_TRACKING_ID",        EV_ABS, 0x039 },
+    { "ABS_MT_PRESSURE",           EV_ABS, 0x03a },
+    { "ABS_MT_DISTANCE",           EV_ABS, 0x03b },
+    { "ABS_MT_TOOL_X",             EV_ABS, 0x03c },
+    { "ABS_MT_TOOL_Y",             EV_ABS, 0x03d },
+
+    { "REL_X",                     EV_REL, 0x000 },
+    { "REL_Y",                     EV_REL, 0x001 },
+    { "REL_Z",                     EV_REL, 0x002 },
+    { "REL_RX",                    EV_REL, 0x003 },
+    { "REL_RY",                    EV_REL, 0x004 },
+    { "REL_RZ",                    EV_REL, 0x005 },
+    { "REL_HWHEEL",                EV_REL, 0x006 },
+    { "REL_DIAL",                  EV_REL, 0x007 },
+    { "REL_WHEEL",                 EV_REL, 0x008 },
+    { "REL_MISC",                  EV_REL, 0x009 },
+    { "REL_RESERVED",              EV_REL, 0x00a },
+    { "REL_WHEEL_HI_RES",          EV_REL, 0x00b },
+    { "REL_HWHEEL_HI_RES",         EV_REL, 0x00c },
+};
+
+static constexpr size_t event_name_count = sizeof(event_names) / sizeof(event_names[0]);
+
+// Code -> index into event_names, -1 for codes without a name
+template<size_t Count>
+struct CodeIndex
+{
+    int16_t index[Count];
+};
+
+template<size_t Count>
+static constexpr CodeIndex<Count> make_code_index(int type)
+{
+    CodeIndex<Count> result{};
+    for (size_t code = 0; code < Count; code++) {
+        result.index[code] = -1;
+    }
+    // Backwards, so the first name of a code is the one that sticks
+    for (size_t i = event_name_count; i-- > 0;) {
+        if (event_names[i].type == type) {
+            result.index[event_names[i].code] = static_cast<int16_t>(i);
+        }
     }
+    return result;
+}
 
-    void add(Enum i, const std::string& name)
-    {
-        enum2string[i] = name;
-        string2enum[name] = i;
+static constexpr CodeIndex<KEY_CNT> key_index = make_code_index<KEY_CNT>(EV_KEY);
+static constexpr CodeIndex<ABS_CNT> abs_index = make_code_index<ABS_CNT>(EV_ABS);
+static constexpr CodeIndex<REL_CNT> rel_index = make_code_index<REL_CNT>(EV_REL);
+
+// Name -> index into event_names, an open addressing hash table that
+// is at most half full, built by the compiler
+static constexpr size_t NAME_SLOTS = 2048;
+static_assert(event_name_count * 2 <= NAME_SLOTS, "NAME_SLOTS too small");
+
+// 32-bit FNV-1a
+static constexpr uint32_t hash_name(const char* str, size_t len)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 16777619u;
     }
+    return hash;
+}
 
-public:
-    Enum operator[](const std::string& str) const
-    {
-        typename std::map<std::string, Enum>::const_iterator i = string2enum.find(str);
-        if (i == string2enum.end())
-        {
-            std::istringstream in(str);
-            Enum tmp;
-            in >> tmp;
-            if (in.fail())
-            {
-                std::ostringstream out;
-                out << "Couldn't convert '" << str << "' to enum " << name << std::endl;
-                throw std::runtime_error(out.str());
-            }
-            else
-            {
-                return tmp;
-            }
-        }
-        else
-        {
-            return i->second;
-        }
+static constexpr size_t name_length(const char* str)
+{
+    size_t len = 0;
+    while (str[len]) {
+        len++;
     }
+    return len;
+}
 
-    std::string operator[](Enum v) const {
-        typename std::map<Enum, std::string>::const_iterator i = enum2string.find(v);
-        if (i == enum2string.end())
-        {
-            // If we can't convert symbolic, just convert the integer to a
-            // string
-            std::ostringstream out;
-            out << v;
-            return out.str();
-        }
-        else
-        {
-            return i->second;
+struct NameIndex
+{
+    int16_t entries[NAME_SLOTS];
+};
+
+static constexpr NameIndex make_name_index()
+{
+    NameIndex result{};
+    for (size_t slot = 0; slot < NAME_SLOTS; slot++) {
+        result.entries[slot] = -1;
+    }
+    for (size_t i = 0; i < event_name_count; i++) {
+        const char* name = event_names[i].name;
+        size_t slot = hash_name(name, name_length(name)) & (NAME_SLOTS - 1);
+        while (result.entries[slot] >= 0) {
+            slot = (slot + 1) & (NAME_SLOTS - 1);
         }
+        result.entries[slot] = static_cast<int16_t>(i);
     }
-};
+    return result;
+}
 
+static constexpr NameIndex name_index = make_name_index();
 
-class EvDevRelEnum : public EnumBox<int>
+static const EventName* find_event_name(const std::string& name)
 {
-public:
-    EvDevRelEnum()
-        : EnumBox<int>("EV_REL")
-    {
-        add(REL_X,               "REL_X");
-        add(REL_Y,               "REL_Y");
-        add(REL_Z,               "REL_Z");
-        add(REL_RX,              "REL_RX");
-        add(REL_RY,              "REL_RY");
-        add(REL_RZ,              "REL_RZ");
-        add(REL_HWHEEL,          "REL_HWHEEL");
-        add(REL_DIAL,            "REL_DIAL");
-        add(REL_WHEEL,           "REL_WHEEL");
-        add(REL_MISC,            "REL_MISC");
+    size_t slot = hash_name(name.data(), name.size()) & (NAME_SLOTS - 1);
+    for (int index; (index = name_index.entries[slot]) >= 0; slot = (slot + 1) & (NAME_SLOTS - 1)) {
+        if (name == event_names[index].name) {
+            return &event_names[index];
+        }
     }
-} evdev_rel_names;
+    return nullptr;
+}
 
-class EvDevAbsEnum : public EnumBox<int>
+// Code of name, which has to be of the given type
+static int name2code(const std::string& name, int type, const char* type_name)
 {
-public:
-    EvDevAbsEnum()
-        : EnumBox<int>("EV_ABS")
-    {
-        add(ABS_X,               "ABS_X");
-        add(ABS_Y,               "ABS_Y");
-        add(ABS_Z,               "ABS_Z");
-        add(ABS_RX,              "ABS_RX");
-        add(ABS_RY,              "ABS_RY");
-        add(ABS_RZ,              "ABS_RZ");
-        add(ABS_THROTTLE,        "ABS_THROTTLE");
-        add(ABS_RUDDER,          "ABS_RUDDER");
-        add(ABS_WHEEL,           "ABS_WHEEL");
-        add(ABS_GAS,             "ABS_GAS");
-        add(ABS_BRAKE,           "ABS_BRAKE");
-        add(ABS_HAT0X,           "ABS_HAT0X");
-        add(ABS_HAT0Y,           "ABS_HAT0Y");
-        add(ABS_HAT1X,           "ABS_HAT1X");
-        add(ABS_HAT1Y,           "ABS_HAT1Y");
-        add(ABS_HAT2X,           "ABS_HAT2X");
-        add(ABS_HAT2Y,           "ABS_HAT2Y");
-        add(ABS_HAT3X,           "ABS_HAT3X");
-        add(ABS_HAT3Y,           "ABS_HAT3Y");
-        add(ABS_PRESSURE,        "ABS_PRESSURE");
-        add(ABS_DISTANCE,        "ABS_DISTANCE");
-        add(ABS_TILT_X,          "ABS_TILT_X");
-        add(ABS_TILT_Y,          "ABS_TILT_Y");
-        add(ABS_TOOL_WIDTH,      "ABS_TOOL_WIDTH");
-        add(ABS_VOLUME,          "ABS_VOLUME");
-        add(ABS_MISC,            "ABS_MISC");
+    const EventName* entry = find_event_name(name);
+    if (!entry || entry->type != type) {
+        throw std::runtime_error("Couldn't convert '" + name + "' to enum " + type_name);
     }
-} evdev_abs_names;
+    return entry->code;
+}
 
-class EvDevBtnEnum : public EnumBox<int>
+// Name of code, the plain number if it has none
+template<size_t Count>
+static std::string code2name(const CodeIndex<Count>& table, int code)
 {
-public:
-    EvDevBtnEnum()
-        : EnumBox<int>("EV_KEY")
-    {
-        // Joystick buttons
-        add(BTN_JOYSTICK,        "BTN_JOYSTICK");
-        add(BTN_TRIGGER,         "BTN_TRIGGER");
-        add(BTN_THUMB,           "BTN_THUMB");
-        add(BTN_THUMB2,          "BTN_THUMB2");
-        add(BTN_TOP,             "BTN_TOP");
-        add(BTN_TOP2,            "BTN_TOP2");
-        add(BTN_PINKIE,          "BTN_PINKIE");
-        add(BTN_BASE,            "BTN_BASE");
-        add(BTN_BASE2,           "BTN_BASE2");
-        add(BTN_BASE3,           "BTN_BASE3");
-        add(BTN_BASE4,           "BTN_BASE4");
-        add(BTN_BASE5,           "BTN_BASE5");
-        add(BTN_BASE6,           "BTN_BASE6");
-        add(BTN_DEAD,            "BTN_DEAD");
-        
-        // Gamepad buttons
-        add(BTN_GAMEPAD,         "BTN_GAMEPAD");
-        add(BTN_A,               "BTN_A");
-        add(BTN_B,               "BTN_B");
-        add(BTN_C,               "BTN_C");
-        add(BTN_X,               "BTN_X");
-        add(BTN_Y,               "BTN_Y");
-        add(BTN_Z,               "BTN_Z");
-        add(BTN_TL,              "BTN_TL");
-        add(BTN_TR,              "BTN_TR");
-        add(BTN_TL2,             "BTN_TL2");
-        add(BTN_TR2,             "BTN_TR2");
-        add(BTN_SELECT,          "BTN_SELECT");
-        add(BTN_START,           "BTN_START");
-        add(BTN_MODE,            "BTN_MODE");
-        add(BTN_THUMBL,          "BTN_THUMBL");
-        add(BTN_THUMBR,          "BTN_THUMBR");
-        
-        // Generic buttons
-        add(BTN_0,               "BTN_0");
-        add(BTN_1,               "BTN_1");
-        add(BTN_2,               "BTN_2");
-        add(BTN_3,               "BTN_3");
-        add(BTN_4,               "BTN_4");
-        add(BTN_5,               "BTN_5");
-        add(BTN_6,               "BTN_6");
-        add(BTN_7,               "BTN_7");
-        add(BTN_8,               "BTN_8");
-        add(BTN_9,               "BTN_9");
+    if (code >= 0 && static_cast<size_t>(code) < Count && table.index[code] >= 0) {
+        return event_names[table.index[code]].name;
     }
-} evdev_btn_names;
+    return std::to_string(code);
+}
 
 // Qt-based implementation to replace X11-specific code
 class KeycodeMapper {
@@ -279,7 +921,15 @@ int qt_keysym2keycode(const std::string& name) {
 
 bool str2event(const std::string& name, int& type, int& code)
 {
-    if (name == "void" || name == "none")
+    // Most names are in the table, which knows their type as well, so
+    // that goes before any prefix comparisons
+    if (const EventName* entry = find_event_name(name))
+    {
+        type = entry->type;
+        code = entry->code;
+        return true;
+    }
+    else if (name == "void" || name == "none")
     {
         type = -1;
         code = -1;
@@ -288,13 +938,13 @@ bool str2event(const std::string& name, int& type, int& code)
     else if (name.compare(0, 3, "REL") == 0)
     {
         type = EV_REL;
-        code = evdev_rel_names[name];
+        code = name2code(name, EV_REL, "EV_REL");
         return true;
     }
     else if (name.compare(0, 3, "ABS") == 0)
     {
         type = EV_ABS;
-        code = evdev_abs_names[name];
+        code = name2code(name, EV_ABS, "EV_ABS");
         return true;
     }
     else if (name.compare(0, 2, "XK") == 0)
@@ -305,8 +955,7 @@ bool str2event(const std::string& name, int& type, int& code)
     }
     else if (name.compare(0, 2, "JS") == 0)
     {
-        int int_value = 0;
-        std::istringstream(name.substr(3)) >> int_value;
+        int int_value = name.size() > 3 ? atoi(name.c_str() + 3) : 0;
 
         type = EV_KEY;
         code = BTN_JOYSTICK + int_value;
@@ -317,7 +966,7 @@ bool str2event(const std::string& name, int& type, int& code)
             name.compare(0, 3, "BTN") == 0)
     {
         type = EV_KEY;
-        code = evdev_btn_names[name];
+        code = name2code(name, EV_KEY, "EV_KEY");
         return true;
     }
     else
@@ -328,15 +977,15 @@ bool str2event(const std::string& name, int& type, int& code)
 
 std::string btn2str(int i)
 {
-    return evdev_btn_names[i];
+    return code2name(key_index, i);
 }
 
 std::string abs2str(int i)
 {
-    return evdev_abs_names[i];
+    return code2name(abs_index, i);
 }
 
 std::string rel2str(int i)
 {
-    return evdev_rel_names[i];
+    return code2name(rel_index, i);
 }
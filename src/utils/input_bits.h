@@ -0,0 +1,137 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_INPUT_BITS_H
+#define JSTEST_QT_INPUT_BITS_H
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdlib.h>
+#include <linux/input.h>
+
+#include "utils/evdev_helper.h"
+
+/**
+ * Fixed size capability bitmap for Bits event codes, in the layout
+ * EVIOCGBIT fills in, so data() can be handed to the ioctl directly.
+ * Counting is done a word at a time with popcount.
+ */
+template<size_t Bits>
+class InputBits
+{
+public:
+    static const size_t WORDS = NLONGS(Bits);
+
+private:
+    std::array<unsigned long, WORDS> m_words;
+
+public:
+    InputBits()
+        : m_words()
+    {}
+
+    unsigned long* data() { return m_words.data(); }
+    const unsigned long* data() const { return m_words.data(); }
+    static constexpr size_t bytes() { return WORDS * sizeof(unsigned long); }
+
+    void clear() { m_words.fill(0); }
+
+    bool test(int bit) const
+    {
+        return bit >= 0 && static_cast<size_t>(bit) < Bits &&
+               (m_words[BIT_WORD(bit)] & BIT_MASK(bit));
+    }
+
+    void set(int bit)
+    {
+        if (bit >= 0 && static_cast<size_t>(bit) < Bits)
+            m_words[BIT_WORD(bit)] |= BIT_MASK(bit);
+    }
+
+    /** Number of set bits in [first, last) */
+    int count(int first = 0, int last = Bits) const
+    {
+        if (first >= last)
+            return 0;
+
+        int result = 0;
+        size_t first_word = BIT_WORD(first);
+        size_t last_word = BIT_WORD(last - 1);
+        for (size_t word = first_word; word <= last_word && word < WORDS; word++) {
+            unsigned long value = m_words[word];
+            if (word == first_word)
+                value &= ~(BIT_MASK(first) - 1);
+            if (word == last_word && (last % BITS_PER_LONG) != 0)
+                value &= BIT_MASK(last) - 1;
+            result += __builtin_popcountl(value);
+        }
+        return result;
+    }
+
+    bool any(int first = 0, int last = Bits) const { return count(first, last) > 0; }
+
+    /** Set bits in [first, last) in ascending order */
+    void collect(int first, int last, std::vector<int>& out) const
+    {
+        for (int bit = first; bit < last; bit++) {
+            if (test(bit))
+                out.push_back(bit);
+        }
+    }
+
+    /** Parse a sysfs capability attribute, hex words with the most
+        significant one first */
+    void parseSysfs(const std::string& text)
+    {
+        clear();
+
+        std::vector<std::string> words;
+        std::istringstream in(text);
+        std::string word;
+        while (in >> word) {
+            words.push_back(word);
+        }
+
+        // The last word holds the lowest bits
+        std::reverse(words.begin(), words.end());
+        for (size_t i = 0; i < words.size() && i < WORDS; i++) {
+            m_words[i] = strtoul(words[i].c_str(), nullptr, 16);
+        }
+    }
+};
+
+typedef InputBits<EV_CNT>   EvBits;
+typedef InputBits<ABS_CNT>  AbsBits;
+typedef InputBits<KEY_CNT>  KeyBits;
+typedef InputBits<FF_CNT>   FfBits;
+typedef InputBits<INPUT_PROP_CNT> PropBits;
+
+/** Has absolute axes and at least one joystick or gamepad button,
+    otherwise every touchpad and tablet would pass as a joystick */
+inline bool is_joystick_bits(const EvBits& ev, const KeyBits& key)
+{
+    return ev.test(EV_ABS) && ev.test(EV_KEY) &&
+           (key.any(BTN_JOYSTICK, BTN_DIGI) ||
+            key.any(BTN_TRIGGER_HAPPY, BTN_TRIGGER_HAPPY40 + 1));
+}
+
+#endif // JSTEST_QT_INPUT_BITS_H
@@ -25,6 +25,9 @@
 #include <linux/input.h>
 #include <libudev.h>
 
+#include "utils/capability_cache.h"
+#include "utils/sysfs_topology.h"
+
 // Static callback required by libinput
 static int open_restricted(const char *path, int flags, void *user_data)
 {
@@ -42,6 +45,22 @@ static const struct libinput_interface interface = {
     .close_restricted = close_restricted,
 };
 
+// Capabilities of the input device behind udev_device, without opening it
+static bool get_capabilities(struct udev_device* udev_device, CapabilityCache::Entry& caps)
+{
+    // The event node hangs off the inputN device that has the capabilities
+    struct udev_device* input = udev_device_get_parent_with_subsystem_devtype(udev_device, "input", nullptr);
+    if (!input)
+        return false;
+
+    SysfsTopology::InputDevice device;
+    if (!SysfsTopology::readDevice(udev_device_get_syspath(input), device))
+        return false;
+
+    caps = CapabilityCache::instance()->get(device);
+    return true;
+}
+
 // Singleton instance
 LibinputHelper* LibinputHelper::instance()
 {
@@ -52,7 +71,10 @@ LibinputHelper* LibinputHelper::instance()
 LibinputHelper::LibinputHelper()
     : m_udev(nullptr),
       m_libinput(nullptr),
-      m_notifier(nullptr)
+      m_path_libinput(nullptr),
+      m_notifier(nullptr),
+      m_registry(),
+      m_handle_count(0)
 {
 }
 
@@ -93,6 +115,13 @@ bool LibinputHelper::initialize()
         return false;
     }
 
+    // The seat context only manages the devices of the seat, handles for
+    // individual nodes have to come from a path context
+    m_path_libinput = libinput_path_create_context(&interface, nullptr);
+    if (!m_path_libinput) {
+        qWarning() << "Failed to create libinput path context";
+    }
+
     // Get libinput file descriptor for monitoring
     int fd = libinput_get_fd(m_libinput);
     
@@ -115,6 +144,19 @@ void LibinputHelper::shutdown()
         m_notifier = nullptr;
     }
 
+    // Unref'ing the path context closes the fds of all handles
+    for (const RegistryEntry& entry : m_registry) {
+        if (entry.handle) {
+            libinput_device_unref(entry.handle);
+        }
+    }
+    m_registry.clear();
+    m_handle_count = 0;
+    if (m_path_libinput) {
+        libinput_unref(m_path_libinput);
+        m_path_libinput = nullptr;
+    }
+
     if (m_libinput) {
         libinput_unref(m_libinput);
         m_libinput = nullptr;
@@ -164,94 +206,34 @@ void LibinputHelper::handleLibinputEvents()
     }
 }
 
+// Check if this is a joystick using various heuristics
+static bool is_joystick(struct udev_device* udev_device)
+{
+    // First check: udev tagging
+    const char* id_joystick = udev_device_get_property_value(udev_device, "ID_INPUT_JOYSTICK");
+    if (id_joystick && strcmp(id_joystick, "1") == 0) {
+        return true;
+    }
+    
+    // Final check: has joystick-like capabilities?
+    CapabilityCache::Entry caps;
+    return get_capabilities(udev_device, caps) &&
+           caps.isJoystick() && caps.has(CapabilityCache::Entry::HAS_ABS_XY);
+}
+
 bool LibinputHelper::isJoystickDevice(libinput_device* device)
 {
     if (!device)
         return false;
         
-    // Check if this is a joystick using various heuristics
-    
     // Get udev device for more detailed info
     struct udev_device* udev_device = libinput_device_get_udev_device(device);
     if (!udev_device)
         return false;
         
-    // First check: udev tagging
-    const char* id_joystick = udev_device_get_property_value(udev_device, "ID_INPUT_JOYSTICK");
-    if (id_joystick && strcmp(id_joystick, "1") == 0) {
-        udev_device_unref(udev_device);
-        return true;
-    }
-    
-    // Second check: is it in the js* device list?
-    const char* devnode = udev_device_get_devnode(udev_device);
-    if (devnode && strstr(devnode, "/dev/input/js") == devnode) {
-        udev_device_unref(udev_device);
-        return true;
-    }
-    
-    // Final check: has joystick-like capabilities?
-    const char* sysname = udev_device_get_sysname(udev_device);
-    if (sysname && strncmp(sysname, "event", 5) == 0) {
-        // Get the corresponding event device
-        char path[PATH_MAX];
-        snprintf(path, sizeof(path), "/dev/input/%s", sysname);
-        
-        // Open the device to check capabilities
-        int fd = open(path, O_RDONLY | O_NONBLOCK);
-        if (fd >= 0) {
-            unsigned long evbit[NLONGS(EV_CNT)] = { 0 };
-            if (ioctl(fd, EVIOCGBIT(0, sizeof(evbit)), evbit) >= 0) {
-                // Check for absolute axes
-                if (evbit[BIT_WORD(EV_ABS)] & BIT_MASK(EV_ABS)) {
-                    unsigned long absbit[NLONGS(ABS_CNT)] = { 0 };
-                    ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absbit)), absbit);
-                    
-                    // Check for buttons
-                    if (evbit[BIT_WORD(EV_KEY)] & BIT_MASK(EV_KEY)) {
-                        unsigned long keybit[NLONGS(KEY_CNT)] = { 0 };
-                        ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keybit)), keybit);
-                        
-                        // Check for joystick buttons
-                        bool has_js_btn = false;
-                        for (int btn = BTN_JOYSTICK; btn < BTN_DIGI; btn++) {
-                            if (keybit[BIT_WORD(btn)] & BIT_MASK(btn)) {
-                                has_js_btn = true;
-                                break;
-                            }
-                        }
-                        
-                        // Check for gamepad buttons
-                        if (!has_js_btn) {
-                            for (int btn = BTN_GAMEPAD; btn < BTN_DPAD_UP; btn++) {
-                                if (keybit[BIT_WORD(btn)] & BIT_MASK(btn)) {
-                                    has_js_btn = true;
-                                    break;
-                                }
-                            }
-                        }
-                        
-                        // Check for common joystick axes
-                        bool has_js_axes = false;
-                        if ((absbit[BIT_WORD(ABS_X)] & BIT_MASK(ABS_X)) &&
-                            (absbit[BIT_WORD(ABS_Y)] & BIT_MASK(ABS_Y))) {
-                            has_js_axes = true;
-                        }
-                        
-                        close(fd);
-                        udev_device_unref(udev_device);
-                        
-                        // If we have joystick buttons and axes, it's likely a joystick
-                        return has_js_btn && has_js_axes;
-                    }
-                }
-            }
-            close(fd);
-        }
-    }
-    
+    bool result = is_joystick(udev_device);
     udev_device_unref(udev_device);
-    return false;
+    return result;
 }
 
 LibinputHelper::DeviceInfo LibinputHelper::getDeviceInfo(libinput_device* device)
@@ -278,69 +260,16 @@ LibinputHelper::DeviceInfo LibinputHelper::getDeviceInfo(libinput_device* device
             info.sysPath = QString::fromUtf8(syspath);
         }
         
-        // Check for force feedback
-        info.hasForceFeedback = false;
-        const char* sysname = udev_device_get_sysname(udev_device);
-        if (sysname && strncmp(sysname, "event", 5) == 0) {
-            char path[PATH_MAX];
-            snprintf(path, sizeof(path), "/dev/input/%s", sysname);
-            
-            int fd = open(path, O_RDONLY | O_NONBLOCK);
-            if (fd >= 0) {
-                unsigned long evbit[NLONGS(EV_CNT)] = { 0 };
-                if (ioctl(fd, EVIOCGBIT(0, sizeof(evbit)), evbit) >= 0) {
-                    if (evbit[BIT_WORD(EV_FF)] & BIT_MASK(EV_FF)) {
-                        info.hasForceFeedback = true;
-                    }
-                }
-                close(fd);
-            }
-        }
-        
-        // Count axis and buttons
-        info.axisCount = 0;
-        info.buttonCount = 0;
-        
-        const char* devnode = udev_device_get_devnode(udev_device);
-        if (devnode) {
-            int fd = open(devnode, O_RDONLY | O_NONBLOCK);
-            if (fd >= 0) {
-                unsigned long evbit[NLONGS(EV_CNT)] = { 0 };
-                unsigned long keybit[NLONGS(KEY_CNT)] = { 0 };
-                unsigned long absbit[NLONGS(ABS_CNT)] = { 0 };
-                
-                if (ioctl(fd, EVIOCGBIT(0, sizeof(evbit)), evbit) >= 0) {
-                    // Count absolute axes
-                    if (evbit[BIT_WORD(EV_ABS)] & BIT_MASK(EV_ABS)) {
-                        ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absbit)), absbit);
-                        for (int i = 0; i < ABS_CNT; i++) {
-                            if (absbit[BIT_WORD(i)] & BIT_MASK(i)) {
-                                info.axisCount++;
-                            }
-                        }
-                    }
-                    
-                    // Count buttons
-                    if (evbit[BIT_WORD(EV_KEY)] & BIT_MASK(EV_KEY)) {
-                        ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keybit)), keybit);
-                        
-                        // Count joystick buttons
-                        for (int btn = BTN_JOYSTICK; btn < BTN_DIGI; btn++) {
-                            if (keybit[BIT_WORD(btn)] & BIT_MASK(btn)) {
-                                info.buttonCount++;
-                            }
-                        }
-                        
-                        // Count gamepad buttons
-                        for (int btn = BTN_GAMEPAD; btn < BTN_DPAD_UP; btn++) {
-                            if (keybit[BIT_WORD(btn)] & BIT_MASK(btn)) {
-                                info.buttonCount++;
-                            }
-                        }
-                    }
-                }
-                close(fd);
-            }
+        // Capabilities come from sysfs and the capability cache
+        CapabilityCache::Entry caps;
+        if (get_capabilities(udev_device, caps)) {
+            info.hasForceFeedback = caps.has(CapabilityCache::Entry::HAS_FORCE_FEEDBACK);
+            info.axisCount = caps.axis_count;
+            info.buttonCount = caps.button_count;
+        } else {
+            info.hasForceFeedback = false;
+            info.axisCount = 0;
+            info.buttonCount = 0;
         }
         
         udev_device_unref(udev_device);
@@ -352,6 +281,37 @@ LibinputHelper::DeviceInfo LibinputHelper::getDeviceInfo(libinput_device* device
     return info;
 }
 
+LibinputHelper::DeviceInfo LibinputHelper::getDeviceInfo(udev_device* udev_device)
+{
+    DeviceInfo info;
+    info.sysPath = QString::fromUtf8(udev_device_get_syspath(udev_device));
+    info.name = "Unknown Device";
+    info.vendorId = 0;
+    info.productId = 0;
+    info.isJoystick = true;
+    info.hasForceFeedback = false;
+    info.axisCount = 0;
+    info.buttonCount = 0;
+
+    // Name and ids sit on the inputN parent, same as the capabilities
+    struct udev_device* input = udev_device_get_parent_with_subsystem_devtype(udev_device, "input", nullptr);
+    SysfsTopology::InputDevice device;
+    if (input && SysfsTopology::readDevice(udev_device_get_syspath(input), device)) {
+        if (!device.name.empty()) {
+            info.name = QString::fromStdString(device.name);
+        }
+        info.vendorId = device.vendor;
+        info.productId = device.product;
+
+        CapabilityCache::Entry caps = CapabilityCache::instance()->get(device);
+        info.hasForceFeedback = caps.has(CapabilityCache::Entry::HAS_FORCE_FEEDBACK);
+        info.axisCount = caps.axis_count;
+        info.buttonCount = caps.button_count;
+    }
+
+    return info;
+}
+
 QVector<LibinputHelper::DeviceInfo> LibinputHelper::findJoystickDevices()
 {
     QVector<DeviceInfo> devices;
@@ -362,36 +322,65 @@ QVector<LibinputHelper::DeviceInfo> LibinputHelper::findJoystickDevices()
         }
     }
     
+    refresh();
+    
+    for (const RegistryEntry& entry : m_registry) {
+        devices.append(entry.info);
+    }
+    
+    return devices;
+}
+
+LibinputHelper::RegistryDiff LibinputHelper::refresh()
+{
+    RegistryDiff diff;
+    diff.unchanged = 0;
+    
+    if (!m_udev) {
+        return diff;
+    }
+    
     // Make sure we have the most current device state
     libinput_dispatch(m_libinput);
     
     // Make a udev query for all input devices to find joysticks
     struct udev_enumerate* enumerate = udev_enumerate_new(m_udev);
     udev_enumerate_add_match_subsystem(enumerate, "input");
+    udev_enumerate_add_match_sysname(enumerate, "event*");
     udev_enumerate_add_match_property(enumerate, "ID_INPUT_JOYSTICK", "1");
     udev_enumerate_scan_devices(enumerate);
     
-    struct udev_list_entry* devices_list = udev_enumerate_get_list_entry(enumerate);
-    struct udev_list_entry* entry;
+    QMap<QString, RegistryEntry> seen;
     
-    // Iterate through all devices found
-    udev_list_entry_foreach(entry, devices_list) {
-        const char* path = udev_list_entry_get_name(entry);
-        struct udev_device* dev = udev_device_new_from_syspath(m_udev, path);
+    // Iterate through all devices found, the event node stands for the
+    // physical device, the inputN parent and the js node are skipped
+    struct udev_list_entry* entry;
+    udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+        QString syspath = QString::fromUtf8(udev_list_entry_get_name(entry));
+        
+        auto it = m_registry.find(syspath);
+        if (it != m_registry.end()) {
+            seen.insert(syspath, it.value());
+            m_registry.erase(it);
+            diff.unchanged += 1;
+            continue;
+        }
+        
+        struct udev_device* dev = udev_device_new_from_syspath(m_udev, udev_list_entry_get_name(entry));
+        if (!dev) {
+            continue;
+        }
         
         const char* devnode = udev_device_get_devnode(dev);
-        if (devnode) {
-            // Try to add this device to our libinput instance
-            libinput_device* libinput_dev = libinput_path_add_device(m_libinput, devnode);
-            if (libinput_dev) {
-                // Check if it's a joystick
-                if (isJoystickDevice(libinput_dev)) {
-                    DeviceInfo info = getDeviceInfo(libinput_dev);
-                    devices.append(info);
-                }
-                
-                // We don't remove the device from libinput context to keep it available for events
-            }
+        if (devnode && is_joystick(dev)) {
+            RegistryEntry registered;
+            registered.info = getDeviceInfo(dev);
+            registered.devnode = QString::fromUtf8(devnode);
+            registered.handle = nullptr;
+            registered.refused = false;
+            
+            seen.insert(syspath, registered);
+            diff.added.append(registered.info);
         }
         
         udev_device_unref(dev);
@@ -399,7 +388,63 @@ QVector<LibinputHelper::DeviceInfo> LibinputHelper::findJoystickDevices()
     
     udev_enumerate_unref(enumerate);
     
-    return devices;
+    // Whatever is left over from the last scan is gone
+    for (const RegistryEntry& gone : m_registry) {
+        if (gone.handle) {
+            libinput_path_remove_device(gone.handle);
+            libinput_device_unref(gone.handle);
+            m_handle_count -= 1;
+        }
+        diff.removed.append(gone.info);
+    }
+    m_registry.swap(seen);
+    
+    // After the removals, so their handles go to whoever waited for one
+    assignHandles();
+    drainPathEvents();
+    
+    CapabilityCache::instance()->save();
+    
+    return diff;
+}
+
+void LibinputHelper::assignHandles()
+{
+    if (!m_path_libinput)
+        return;
+    
+    for (RegistryEntry& entry : m_registry) {
+        if (m_handle_count >= MAX_HANDLES)
+            break;
+        
+        if (entry.handle || entry.refused)
+            continue;
+        
+        // libinput turns down devices that are only joysticks, those
+        // are listed anyway, they simply don't get a handle
+        entry.handle = libinput_path_add_device(m_path_libinput, entry.devnode.toUtf8().constData());
+        if (entry.handle) {
+            libinput_device_ref(entry.handle);
+            m_handle_count += 1;
+        } else {
+            entry.refused = true;
+        }
+    }
+}
+
+void LibinputHelper::drainPathEvents()
+{
+    if (!m_path_libinput)
+        return;
+    
+    // Every add and remove queues an event, nobody is interested in
+    // them, but left alone they would pile up
+    libinput_dispatch(m_path_libinput);
+    
+    struct libinput_event* event;
+    while ((event = libinput_get_event(m_path_libinput)) != nullptr) {
+        libinput_event_destroy(event);
+    }
 }
 
 void LibinputHelper::registerDeviceCallback(std::function<void(bool added, const DeviceInfo&)> callback)
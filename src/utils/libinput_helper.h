@@ -33,7 +33,12 @@
 struct libinput;
 struct libinput_device;
 struct udev;
+struct udev_device;
 
+// The application lists devices from sysfs, see JoystickFactory and
+// JoystickProber, so nothing in it opens the libinput contexts here.
+// The registry behind refresh() and findJoystickDevices() is used by
+// libinput_test and registry_stress only.
 class LibinputHelper : public QObject {
     Q_OBJECT
 
@@ -50,6 +55,18 @@ public:
         int buttonCount;
     };
 
+    // Outcome of a refresh() compared to the previous one
+    struct RegistryDiff {
+        QVector<DeviceInfo> added;
+        QVector<DeviceInfo> removed;
+        int unchanged;
+    };
+
+    // Upper bound for the libinput handles, and with that the fds, the
+    // registry keeps open. Devices beyond that are still listed and get
+    // a handle once another device gives up its own.
+    static const int MAX_HANDLES = 32;
+
     // Singleton access
     static LibinputHelper* instance();
 
@@ -62,6 +79,14 @@ public:
     // Find all joystick devices
     QVector<DeviceInfo> findJoystickDevices();
 
+    // Rescan udev and bring the registry up to date, devices that are
+    // already known are left alone
+    RegistryDiff refresh();
+
+    // Number of devices in the registry and of libinput handles held
+    int getDeviceCount() const { return m_registry.size(); }
+    int getHandleCount() const { return m_handle_count; }
+
     // Check if a device is a joystick
     static bool isJoystickDevice(libinput_device* device);
 
@@ -86,11 +111,33 @@ private:
 
     // Helper to extract device info
     DeviceInfo getDeviceInfo(libinput_device* device);
+    static DeviceInfo getDeviceInfo(udev_device* udev_device);
+
+    // Read and drop whatever the path context queued up
+    void drainPathEvents();
+
+    // Give entries without a handle one while there are handles left
+    void assignHandles();
+
+    // One entry per physical device, keyed by the syspath of its event
+    // node. The handle is a live device in the path context, it is how
+    // the registry knows that libinput accepts the device, nothing reads
+    // input through it. It is null if libinput refused the device or
+    // MAX_HANDLES was reached.
+    struct RegistryEntry {
+        DeviceInfo info;
+        QString devnode;
+        libinput_device* handle;
+        bool refused;   // not retried, libinput turns it down every time
+    };
 
     // Member variables
     struct udev* m_udev;
     struct libinput* m_libinput;
+    struct libinput* m_path_libinput;  // holds the registry handles
     QSocketNotifier* m_notifier;
+    QMap<QString, RegistryEntry> m_registry;
+    int m_handle_count;
     QVector<std::function<void(bool added, const DeviceInfo&)>> m_callbacks;
 
     // Prohibit copying
@@ -0,0 +1,232 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "utils/sysfs_topology.h"
+
+#include <algorithm>
+#include <ctype.h>
+#include <fstream>
+#include <dirent.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <linux/input.h>
+
+#include "utils/evdev_helper.h"
+
+// First line of a sysfs attribute, empty if it can't be read
+static std::string read_attribute(const std::string& path)
+{
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+static uint16_t read_hex_attribute(const std::string& path)
+{
+    return static_cast<uint16_t>(strtoul(read_attribute(path).c_str(), nullptr, 16));
+}
+
+static std::string resolve_path(const std::string& path)
+{
+    char buffer[PATH_MAX];
+    if (realpath(path.c_str(), buffer)) {
+        return buffer;
+    }
+    return std::string();
+}
+
+// 64-bit FNV-1a
+static uint64_t hash_string(const std::string& str)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool starts_with(const char* str, const char* prefix)
+{
+    return strncmp(str, prefix, strlen(prefix)) == 0;
+}
+
+void SysfsTopology::InputDevice::parseCapabilities()
+{
+    if (caps_ev.empty()) {
+        caps_ev  = read_attribute(syspath + "/capabilities/ev");
+        caps_abs = read_attribute(syspath + "/capabilities/abs");
+        caps_key = read_attribute(syspath + "/capabilities/key");
+    }
+
+    evbit.parseSysfs(caps_ev);
+    absbit.parseSysfs(caps_abs);
+    keybit.parseSysfs(caps_key);
+}
+
+int SysfsTopology::InputDevice::getAxisCount() const
+{
+    return absbit.count();
+}
+
+int SysfsTopology::InputDevice::getButtonCount() const
+{
+    // joydev takes everything from BTN_JOYSTICK up, then BTN_MISC
+    return keybit.count(BTN_MISC, KEY_CNT);
+}
+
+bool SysfsTopology::InputDevice::isJoystick() const
+{
+    return is_joystick_bits(evbit, keybit);
+}
+
+bool SysfsTopology::readDevice(const std::string& syspath, InputDevice& device)
+{
+    if (syspath.empty())
+        return false;
+
+    device.syspath = syspath;
+    device.input = syspath.substr(syspath.rfind('/') + 1);
+    if (!starts_with(device.input.c_str(), "input"))
+        return false;
+
+    const std::string& base = device.syspath;
+    device.parent = resolve_path(base + "/device");
+    device.name = read_attribute(base + "/name");
+    device.phys = read_attribute(base + "/phys");
+    device.uniq = read_attribute(base + "/uniq");
+
+    // "input:b0003v046DpC215e0111-e0,1,3,k120,...,ra0,1,5,...", one read
+    // instead of the four id and three capability attributes
+    std::string modalias = read_attribute(base + "/modalias");
+    device.caps_ev.clear();
+    device.caps_abs.clear();
+    device.caps_key.clear();
+    if (sscanf(modalias.c_str(), "input:b%4hxv%4hxp%4hxe%4hx",
+               &device.bustype, &device.vendor, &device.product, &device.version) == 4) {
+        device.caps_hash = hash_string(modalias);
+    } else {
+        device.bustype = read_hex_attribute(base + "/id/bustype");
+        device.vendor  = read_hex_attribute(base + "/id/vendor");
+        device.product = read_hex_attribute(base + "/id/product");
+        device.version = read_hex_attribute(base + "/id/version");
+
+        device.caps_ev  = read_attribute(base + "/capabilities/ev");
+        device.caps_abs = read_attribute(base + "/capabilities/abs");
+        device.caps_key = read_attribute(base + "/capabilities/key");
+        device.caps_hash = hash_string(device.caps_ev + '\n' + device.caps_abs + '\n' + device.caps_key);
+    }
+
+    // The handlers are subdirectories of the input device
+    device.js.clear();
+    device.event.clear();
+    DIR* handlers = opendir(base.c_str());
+    if (handlers) {
+        while (struct dirent* handler = readdir(handlers)) {
+            if (starts_with(handler->d_name, "js")) {
+                device.js = handler->d_name;
+            } else if (starts_with(handler->d_name, "event")) {
+                device.event = handler->d_name;
+            }
+        }
+        closedir(handlers);
+    }
+
+    return true;
+}
+
+SysfsTopology::SysfsTopology(const std::string& root)
+    : m_devices(),
+      m_handler_index()
+{
+    DIR* dir = opendir(root.c_str());
+    if (!dir) {
+        return;
+    }
+
+    while (struct dirent* entry = readdir(dir)) {
+        if (!starts_with(entry->d_name, "input"))
+            continue;
+
+        InputDevice device;
+        if (readDevice(resolve_path(root + "/" + entry->d_name), device)) {
+            m_devices.push_back(device);
+        }
+    }
+
+    closedir(dir);
+
+    // readdir() order is arbitrary, keep the output stable
+    std::sort(m_devices.begin(), m_devices.end(), [](const InputDevice& lhs, const InputDevice& rhs) {
+        if (lhs.input.size() != rhs.input.size())
+            return lhs.input.size() < rhs.input.size();
+        return lhs.input < rhs.input;
+    });
+
+    for (size_t i = 0; i < m_devices.size(); i++) {
+        if (!m_devices[i].js.empty()) {
+            m_handler_index[m_devices[i].js] = i;
+        }
+        if (!m_devices[i].event.empty()) {
+            m_handler_index[m_devices[i].event] = i;
+        }
+    }
+}
+
+std::string SysfsTopology::findSibling(const std::string& devnode, const std::string& kind,
+                                       const std::string& root)
+{
+    std::string handler = devnode.substr(devnode.rfind('/') + 1);
+
+    // The device link of a handler points to the input device, which
+    // has all of its handlers as subdirectories
+    DIR* dir = opendir((root + "/" + handler + "/device").c_str());
+    if (!dir) {
+        return std::string();
+    }
+
+    std::string result;
+    while (struct dirent* entry = readdir(dir)) {
+        if (starts_with(entry->d_name, kind.c_str()) &&
+            isdigit(static_cast<unsigned char>(entry->d_name[kind.size()]))) {
+            result = "/dev/input/" + std::string(entry->d_name);
+            break;
+        }
+    }
+    closedir(dir);
+
+    return result;
+}
+
+const SysfsTopology::InputDevice* SysfsTopology::find(const std::string& handler) const
+{
+    std::string name = handler;
+    size_t slash = name.rfind('/');
+    if (slash != std::string::npos) {
+        name = name.substr(slash + 1);
+    }
+
+    auto it = m_handler_index.find(name);
+    if (it == m_handler_index.end())
+        return nullptr;
+
+    return &m_devices[it->second];
+}
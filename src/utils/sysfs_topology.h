@@ -0,0 +1,112 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_SYSFS_TOPOLOGY_H
+#define JSTEST_QT_SYSFS_TOPOLOGY_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+#include "utils/input_bits.h"
+
+/**
+ * Index of the input devices in /sys/class/input. Every inputN entry
+ * knows its jsN and eventN handlers, the device it hangs off and its
+ * ids and capabilities, all read from sysfs attributes without opening
+ * a single device node.
+ */
+class SysfsTopology
+{
+public:
+    struct InputDevice {
+        std::string input;      // "input12"
+        std::string syspath;    // resolved /sys/devices/.../input12
+        std::string parent;     // resolved path of the USB interface, BT device, ...
+        std::string name;
+        std::string phys;
+        std::string uniq;
+
+        std::string js;         // "js0", empty if there is no joydev handler
+        std::string event;      // "event5", empty if there is no evdev handler
+
+        uint16_t bustype;
+        uint16_t vendor;
+        uint16_t product;
+        uint16_t version;
+
+        // Hash of the modalias attribute, which has the ids and every
+        // capability bitmap in a single read, so it changes whenever the
+        // kernel reports different capabilities
+        uint64_t caps_hash;
+
+        // Raw capabilities/{ev,abs,key} attributes and the bitmaps decoded
+        // from them, empty and all zero until parseCapabilities() is
+        // called, usually the capability cache already knows the answer
+        std::string caps_ev;
+        std::string caps_abs;
+        std::string caps_key;
+        EvBits evbit;
+        AbsBits absbit;
+        KeyBits keybit;
+
+        void parseCapabilities();
+
+        bool hasEv(int type) const { return evbit.test(type); }
+        bool hasAbs(int code) const { return absbit.test(code); }
+        bool hasKey(int code) const { return keybit.test(code); }
+
+        /** Axis and button count the way joydev numbers them */
+        int getAxisCount() const;
+        int getButtonCount() const;
+
+        /** Has absolute axes and at least one joystick or gamepad button,
+            the same test EvdevJoystick uses */
+        bool isJoystick() const;
+
+        std::string getJsPath() const { return js.empty() ? std::string() : "/dev/input/" + js; }
+        std::string getEventPath() const { return event.empty() ? std::string() : "/dev/input/" + event; }
+    };
+
+    /** Scan sysfs, root can be pointed elsewhere for testing */
+    explicit SysfsTopology(const std::string& root = "/sys/class/input");
+
+    /** Read a single input device, syspath is the /sys/devices/.../inputN
+        directory. Returns false if it doesn't look like one. */
+    static bool readDevice(const std::string& syspath, InputDevice& device);
+
+    const std::vector<InputDevice>& getDevices() const { return m_devices; }
+
+    /** Look up a device by handler name ("js0", "event5") or by device
+        node path ("/dev/input/js0"), returns nullptr if unknown */
+    const InputDevice* find(const std::string& handler) const;
+
+    /** Find the handler of the given kind ("event", "js") that belongs
+        to the same input device as devnode, e.g. "/dev/input/event3" for
+        "/dev/input/js0". This only looks at that one device in sysfs.
+        Returns an empty string if there is none. */
+    static std::string findSibling(const std::string& devnode, const std::string& kind,
+                                   const std::string& root = "/sys/class/input");
+
+private:
+    std::vector<InputDevice> m_devices;
+    std::unordered_map<std::string, size_t> m_handler_index;
+};
+
+#endif // JSTEST_QT_SYSFS_TOPOLOGY_H
@@ -0,0 +1,158 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "utils/wayland_helper.h"
+
+#include <QDebug>
+#include <string.h>
+#include <libudev.h>
+
+#include "joystick_event_hub.h"
+#include "joystick_monitor.h"
+
+WaylandInputHelper* WaylandInputHelper::s_instance = nullptr;
+
+WaylandInputHelper* WaylandInputHelper::instance()
+{
+    if (!s_instance) {
+        s_instance = new WaylandInputHelper;
+    }
+    return s_instance;
+}
+
+void WaylandInputHelper::destroy()
+{
+    delete s_instance;
+    s_instance = nullptr;
+}
+
+WaylandInputHelper::WaylandInputHelper()
+    : m_devices(),
+      m_generation(1),
+      m_devices_generation(0)
+{
+    JoystickMonitor* monitor = JoystickMonitor::instance();
+    connect(monitor, &JoystickMonitor::deviceAdded, this, &WaylandInputHelper::invalidate);
+    connect(monitor, &JoystickMonitor::deviceRemoved, this, &WaylandInputHelper::invalidate);
+}
+
+WaylandInputHelper::~WaylandInputHelper()
+{
+}
+
+void WaylandInputHelper::invalidate()
+{
+    m_generation += 1;
+}
+
+QVector<WaylandInputHelper::DeviceInfo> WaylandInputHelper::findInputDevices(DeviceType type)
+{
+    // Without a monitor nobody would ever tell us about changes
+    if (!JoystickMonitor::instance()->isActive()) {
+        invalidate();
+    }
+
+    if (m_devices_generation != m_generation) {
+        enumerate();
+    }
+
+    if (type == UNKNOWN) {
+        return m_devices;
+    }
+
+    QVector<DeviceInfo> devices;
+    for (const DeviceInfo& info : m_devices) {
+        if (info.type == type) {
+            devices.append(info);
+        }
+    }
+    return devices;
+}
+
+void WaylandInputHelper::enumerate()
+{
+    m_devices.clear();
+    m_devices_generation = m_generation;
+
+    // The context lives as long as the hub, no need for one per query
+    struct udev* udev = JoystickEventHub::instance()->getUdev();
+    if (!udev) {
+        qWarning() << "Failed to initialize udev";
+        return;
+    }
+
+    struct udev_enumerate* enumerate = udev_enumerate_new(udev);
+    udev_enumerate_add_match_subsystem(enumerate, "input");
+    udev_enumerate_add_match_sysname(enumerate, "event*");
+    udev_enumerate_scan_devices(enumerate);
+    
+    // Iterate through all devices found
+    struct udev_list_entry* entry;
+    udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+        const char* path = udev_list_entry_get_name(entry);
+        struct udev_device* dev = udev_device_new_from_syspath(udev, path);
+        if (!dev) {
+            continue;
+        }
+        
+        // Get device information
+        struct udev_device* parent = udev_device_get_parent_with_subsystem_devtype(
+            dev, "input", NULL);
+        const char* devnode = udev_device_get_devnode(dev);
+        const char* name = parent ? udev_device_get_property_value(parent, "NAME") : nullptr;
+            
+        if (devnode && name) {
+            // Process the name (remove quotes)
+            QString cleanName = QString(name);
+            if (cleanName.startsWith('"') && cleanName.endsWith('"')) {
+                cleanName = cleanName.mid(1, cleanName.length() - 2);
+            }
+            
+            DeviceInfo info;
+            info.path = QString(devnode);
+            info.name = cleanName;
+            info.sysPath = QString(path);
+            info.type = determineDeviceType(parent);
+            m_devices.append(info);
+        }
+        
+        udev_device_unref(dev);
+    }
+    
+    udev_enumerate_unref(enumerate);
+}
+
+WaylandInputHelper::DeviceType WaylandInputHelper::determineDeviceType(struct udev_device* dev)
+{
+    // Check for joystick capabilities
+    if (udev_device_get_property_value(dev, "ID_INPUT_JOYSTICK")) {
+        return JOYSTICK;
+    }
+    
+    // Check for keyboard capabilities
+    if (udev_device_get_property_value(dev, "ID_INPUT_KEYBOARD")) {
+        return KEYBOARD;
+    }
+    
+    // Check for mouse capabilities
+    if (udev_device_get_property_value(dev, "ID_INPUT_MOUSE")) {
+        return MOUSE;
+    }
+    
+    return UNKNOWN;
+}
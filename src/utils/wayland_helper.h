@@ -20,14 +20,12 @@
 #define JSTEST_QT_WAYLAND_HELPER_H
 
 #include <QObject>
-#include <QSocketNotifier>
 #include <QString>
-#include <QMap>
-#include <linux/input.h>
-#include <fcntl.h>
-#include <unistd.h>
-#include <sys/ioctl.h>
-#include <libudev.h>
+#include <QVector>
+#include <stdint.h>
+
+// Forward declaration to avoid including libudev in our header
+struct udev_device;
 
 class WaylandInputHelper : public QObject {
     Q_OBJECT
@@ -49,107 +47,39 @@ public:
         DeviceType type;
     };
 
-    static WaylandInputHelper* instance() {
-        static WaylandInputHelper instance;
-        return &instance;
-    }
-
-    // Find all input devices of a specific type
-    QVector<DeviceInfo> findInputDevices(DeviceType type = JOYSTICK) {
-        QVector<DeviceInfo> devices;
-        
-        struct udev* udev = udev_new();
-        if (!udev) {
-            qWarning() << "Failed to initialize udev";
-            return devices;
-        }
-
-        struct udev_enumerate* enumerate = udev_enumerate_new(udev);
-        udev_enumerate_add_match_subsystem(enumerate, "input");
-        
-        // Add specific property match for joysticks
-        if (type == JOYSTICK) {
-            udev_enumerate_add_match_property(enumerate, "ID_INPUT_JOYSTICK", "1");
-        }
-        
-        udev_enumerate_scan_devices(enumerate);
-        
-        struct udev_list_entry* devices_list = udev_enumerate_get_list_entry(enumerate);
-        struct udev_list_entry* entry;
-        
-        // Iterate through all devices found
-        udev_list_entry_foreach(entry, devices_list) {
-            const char* path = udev_list_entry_get_name(entry);
-            struct udev_device* dev = udev_device_new_from_syspath(udev, path);
-            
-            // Skip virtual devices
-            const char* sysname = udev_device_get_sysname(dev);
-            if (strncmp(sysname, "event", 5) != 0) {
-                udev_device_unref(dev);
-                continue;
-            }
-            
-            // Get device information
-            struct udev_device* parent = udev_device_get_parent_with_subsystem_devtype(
-                dev, "input", NULL);
-                
-            if (parent) {
-                const char* devnode = udev_device_get_devnode(dev);
-                if (devnode) {
-                    const char* name = udev_device_get_property_value(parent, "NAME");
-                    if (name) {
-                        // Process the name (remove quotes)
-                        QString cleanName = QString(name);
-                        if (cleanName.startsWith('"') && cleanName.endsWith('"')) {
-                            cleanName = cleanName.mid(1, cleanName.length() - 2);
-                        }
-                        
-                        // Determine device type
-                        DeviceType deviceType = determineDeviceType(parent);
-                        
-                        if (deviceType == type || type == UNKNOWN) {
-                            DeviceInfo info;
-                            info.path = QString(devnode);
-                            info.name = cleanName;
-                            info.sysPath = QString(path);
-                            info.type = deviceType;
-                            devices.append(info);
-                        }
-                    }
-                }
-            }
-            
-            udev_device_unref(dev);
-        }
-        
-        udev_enumerate_unref(enumerate);
-        udev_unref(udev);
-        
-        return devices;
-    }
+    static WaylandInputHelper* instance();
+
+    /** Has to be called before JoystickMonitor::destroy() */
+    static void destroy();
+
+    // Find all input devices of a specific type, UNKNOWN returns all of
+    // them. The udev enumeration is only redone after a hotplug event,
+    // until then this answers from the previous result.
+    QVector<DeviceInfo> findInputDevices(DeviceType type = JOYSTICK);
+
+    // Bumped whenever udev reports an input device coming or going, a
+    // caller that remembers it can tell whether a new query is needed
+    uint64_t getGeneration() const { return m_generation; }
 
 private:
-    WaylandInputHelper() {}
-    ~WaylandInputHelper() {}
-    
-    DeviceType determineDeviceType(struct udev_device* dev) {
-        // Check for joystick capabilities
-        if (udev_device_get_property_value(dev, "ID_INPUT_JOYSTICK")) {
-            return JOYSTICK;
-        }
-        
-        // Check for keyboard capabilities
-        if (udev_device_get_property_value(dev, "ID_INPUT_KEYBOARD")) {
-            return KEYBOARD;
-        }
-        
-        // Check for mouse capabilities
-        if (udev_device_get_property_value(dev, "ID_INPUT_MOUSE")) {
-            return MOUSE;
-        }
-        
-        return UNKNOWN;
-    }
+    static WaylandInputHelper* s_instance;
+
+    WaylandInputHelper();
+    ~WaylandInputHelper();
+
+    void invalidate();
+    void enumerate();
+
+    static DeviceType determineDeviceType(struct udev_device* dev);
+
+    // Every event node with its type, valid for m_devices_generation
+    QVector<DeviceInfo> m_devices;
+    uint64_t m_generation;
+    uint64_t m_devices_generation;
+
+    // Prohibit copying
+    WaylandInputHelper(const WaylandInputHelper&) = delete;
+    WaylandInputHelper& operator=(const WaylandInputHelper&) = delete;
 };
 
 #endif // JSTEST_QT_WAYLAND_HELPER_H
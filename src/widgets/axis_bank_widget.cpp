@@ -0,0 +1,238 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "widgets/axis_bank_widget.h"
+
+#include <QEvent>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPaintEvent>
+#include <algorithm>
+
+static const char glyph_chars[] = "0123456789-";
+
+AxisBankWidget::AxisBankWidget(int axis_count_, int rows_, QWidget* parent)
+    : QWidget(parent),
+      axis_count(axis_count_),
+      rows(rows_),
+      values(axis_count_, 0),
+      label_width(0),
+      value_width(0),
+      glyph_width(0),
+      row_height(0),
+      spacing(5),
+      background(),
+      glyphs()
+{
+    updateLayout();
+    
+    // Set widget attributes for better rendering on Wayland
+    setAttribute(Qt::WA_OpaquePaintEvent, false);
+    setAttribute(Qt::WA_TranslucentBackground, false);
+    
+    // Use a proper size policy
+    setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+}
+
+void
+AxisBankWidget::updateLayout()
+{
+    QFontMetrics fm(font());
+    
+    glyph_width = 0;
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        glyph_width = std::max(glyph_width, fm.horizontalAdvance(QString(QChar(glyph_chars[i]))));
+    }
+    
+    label_width = fm.horizontalAdvance(QString("Axis %1: ").arg(std::max(0, axis_count - 1)));
+    value_width = std::max(60, glyph_width * 6 + 4);  // room for "-32767"
+    row_height = fm.height() + 6;
+    
+    int columns = (axis_count + rows - 1) / rows;
+    int visible_rows = std::min(axis_count, rows);
+    int column_width = label_width + BAR_WIDTH + value_width + 2 * spacing;
+    setFixedSize(std::max(0, columns * (column_width + spacing) - spacing),
+                 std::max(0, visible_rows * (row_height + spacing) - spacing));
+    
+    // The caches are rebuilt on the next paint
+    background = QPixmap();
+    glyphs = QPixmap();
+}
+
+int
+AxisBankWidget::getValue(int number) const
+{
+    return (number >= 0 && number < axis_count) ? values[number] : 0;
+}
+
+QRect
+AxisBankWidget::rowRect(int number) const
+{
+    int column_width = label_width + BAR_WIDTH + value_width + 2 * spacing;
+    return QRect((number / rows) * (column_width + spacing),
+                 (number % rows) * (row_height + spacing),
+                 column_width, row_height);
+}
+
+void
+AxisBankWidget::updateCache()
+{
+    const qreal dpr = devicePixelRatioF();
+    if (!background.isNull() &&
+        background.devicePixelRatio() == dpr &&
+        background.size() == size() * dpr)
+    {
+        return;
+    }
+    
+    background = QPixmap(size() * dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(Qt::transparent);
+    
+    {
+        QPainter painter(&background);
+        painter.setFont(font());
+        
+        for (int i = 0; i < axis_count; ++i)
+        {
+            QRect row = rowRect(i);
+            
+            painter.setPen(palette().color(QPalette::WindowText));
+            painter.drawText(QRect(row.x(), row.y(), label_width, row_height),
+                             Qt::AlignLeft | Qt::AlignVCenter,
+                             QString("Axis %1: ").arg(i));
+            
+            painter.setPen(palette().color(QPalette::Mid));
+            painter.setBrush(palette().color(QPalette::Base));
+            painter.drawRect(row.x() + label_width + spacing, row.y(), BAR_WIDTH - 1, row_height - 1);
+        }
+    }
+    
+    // One cell per glyph, side by side
+    glyphs = QPixmap(QSize(glyph_width * GLYPH_COUNT, row_height) * dpr);
+    glyphs.setDevicePixelRatio(dpr);
+    glyphs.fill(Qt::transparent);
+    
+    {
+        QPainter painter(&glyphs);
+        painter.setFont(font());
+        painter.setPen(palette().color(QPalette::WindowText));
+        
+        for (int i = 0; i < GLYPH_COUNT; ++i)
+        {
+            painter.drawText(QRect(i * glyph_width, 0, glyph_width, row_height),
+                             Qt::AlignCenter,
+                             QString(QChar(glyph_chars[i])));
+        }
+    }
+}
+
+void
+AxisBankWidget::drawValue(QPainter& painter, const QRect& rect, int value) const
+{
+    char text[8];
+    int len = 0;
+    
+    // Digits back to front, right aligned like the value labels were
+    unsigned magnitude = value < 0 ? -value : value;
+    do {
+        text[len++] = magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude > 0);
+    
+    if (value < 0) {
+        text[len++] = 10;  // '-'
+    }
+    
+    const qreal dpr = glyphs.devicePixelRatio();
+    int x = rect.right() + 1 - glyph_width;
+    for (int i = 0; i < len; ++i, x -= glyph_width)
+    {
+        painter.drawPixmap(QRectF(x, rect.y(), glyph_width, row_height),
+                           glyphs,
+                           QRectF(text[i] * glyph_width * dpr, 0,
+                                  glyph_width * dpr, row_height * dpr));
+    }
+}
+
+void
+AxisBankWidget::paintEvent(QPaintEvent* event)
+{
+    if (axis_count == 0)
+    {
+        return;
+    }
+    
+    updateCache();
+    
+    const qreal dpr = background.devicePixelRatio();
+    const QRect exposed = event->rect();
+    
+    QPainter painter(this);
+    painter.drawPixmap(QRectF(exposed), background,
+                       QRectF(exposed.x() * dpr, exposed.y() * dpr,
+                              exposed.width() * dpr, exposed.height() * dpr));
+    
+    const QColor fill = palette().color(QPalette::Highlight);
+    for (int i = 0; i < axis_count; ++i)
+    {
+        QRect row = rowRect(i);
+        if (!exposed.intersects(row))
+        {
+            continue;
+        }
+        
+        // Bar filled from the left, the same 0..100% a QProgressBar showed
+        int bar_x = row.x() + label_width + spacing;
+        int filled = (values[i] + 32767) * (BAR_WIDTH - 2) / 65534;
+        painter.fillRect(bar_x + 1, row.y() + 1, filled, row_height - 2, fill);
+        
+        drawValue(painter, QRect(bar_x + BAR_WIDTH + spacing, row.y(), value_width, row_height), values[i]);
+    }
+}
+
+void
+AxisBankWidget::changeEvent(QEvent* event)
+{
+    if (event->type() == QEvent::FontChange ||
+        event->type() == QEvent::PaletteChange)
+    {
+        updateLayout();
+        update();
+    }
+    
+    QWidget::changeEvent(event);
+}
+
+void
+AxisBankWidget::setValue(int number, int value)
+{
+    if (number < 0 || number >= axis_count)
+    {
+        return;
+    }
+    
+    int16_t clamped = std::max(-32767, std::min(32767, value));
+    if (values[number] == clamped)
+    {
+        return;
+    }
+    
+    values[number] = clamped;
+    update(rowRect(number));
+}
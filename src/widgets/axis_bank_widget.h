@@ -0,0 +1,87 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_AXIS_BANK_WIDGET_H
+#define JSTEST_QT_AXIS_BANK_WIDGET_H
+
+#include <QWidget>
+#include <QPixmap>
+#include <QRect>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * Label, bar and value of every axis of a device in a single widget,
+ * ten axes to a column like the axis grid of the test dialog used to
+ * be. Labels and bar frames are rendered once into a background
+ * pixmap, values are drawn from a cache of pre-rendered digit glyphs,
+ * and setValue() only invalidates the row of an axis whose value
+ * actually changed.
+ */
+class AxisBankWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static const int BAR_WIDTH = 100;
+
+private:
+    // Characters of the glyph cache, in this order
+    static const int GLYPH_COUNT = 11;  // 0-9 and '-'
+
+    int axis_count;
+    int rows;
+
+    std::vector<int16_t> values;
+
+    // Layout, derived from the font
+    int label_width;
+    int value_width;
+    int glyph_width;
+    int row_height;
+    int spacing;
+
+    // Labels and bar frames, and the value glyphs, for the current size
+    // and device pixel ratio
+    QPixmap background;
+    QPixmap glyphs;
+
+    void updateLayout();
+    void updateCache();
+    void drawValue(QPainter& painter, const QRect& rect, int value) const;
+
+public:
+    AxisBankWidget(int axis_count, int rows = 10, QWidget* parent = nullptr);
+
+    int getAxisCount() const { return axis_count; }
+    int getValue(int number) const;
+
+    /** Area of the row of axis number in widget coordinates */
+    QRect rowRect(int number) const;
+
+    void paintEvent(QPaintEvent* event) override;
+
+protected:
+    void changeEvent(QEvent* event) override;
+
+public slots:
+    /** value is clamped to -32767..32767 */
+    void setValue(int number, int value);
+};
+
+#endif // JSTEST_QT_AXIS_BANK_WIDGET_H
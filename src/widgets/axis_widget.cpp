@@ -19,37 +19,110 @@
 
 #include "widgets/axis_widget.h"
 
+#include <QAction>
 #include <QPainter>
 #include <QPainterPath>
-#include <sstream>
-#include <iomanip>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <algorithm>
+#include <math.h>
+
+// Heatmap colors by level, transparent blue for a few hits up to opaque
+// red for the cells the stick keeps returning to
+static const int HEATMAP_LEVELS = 64;
+
+static const QRgb* heatmap_ramp()
+{
+    static const std::vector<QRgb> ramp = [] {
+        std::vector<QRgb> result(HEATMAP_LEVELS);
+        for (int i = 0; i < HEATMAP_LEVELS; ++i)
+        {
+            double t = double(i) / (HEATMAP_LEVELS - 1);
+            int alpha = i == 0 ? 0 : 64 + int(160 * t);
+            QColor color = QColor::fromHsvF((1.0 - t) * 0.66, 1.0, 1.0);
+            // QImage wants premultiplied values
+            result[i] = qRgba(color.red() * alpha / 255, color.green() * alpha / 255,
+                              color.blue() * alpha / 255, alpha);
+        }
+        return result;
+    }();
+    return ramp.data();
+}
+
+// Logarithmic, so the cells around the center the stick keeps returning
+// to don't wash out the ones it only passes through. Only changes are
+// recorded, a stick that rests adds no hits. Saturates at about a
+// million hits.
+static int heatmap_level(uint32_t count)
+{
+    return std::min(HEATMAP_LEVELS - 1, int(log2(double(count) + 1.0) * 3.2));
+}
 
 AxisWidget::AxisWidget(int width, int height, bool show_values_, QWidget* parent)
     : QWidget(parent),
-      x(0), y(0), raw_x(0), raw_y(0), show_values(show_values_)
+      x(0), y(0), raw_x(0), raw_y(0), show_values(show_values_),
+      background(),
+      value_font(QFontDatabase::systemFont(QFontDatabase::FixedFont)),
+      value_rect(),
+      trail(),
+      trail_head(0),
+      trail_size(0),
+      heatmap_enabled(false),
+      heatmap_counts(),
+      heatmap()
 {
     setFixedSize(width, height);
     
+    // Use system font for better scaling on HiDPI displays
+    value_font.setPointSize(10);
+    
     // Set widget attributes for better rendering on Wayland
     setAttribute(Qt::WA_OpaquePaintEvent, false);
     setAttribute(Qt::WA_TranslucentBackground, false);
     
     // Use a proper size policy
     setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    
+    // Trail and heatmap are off until asked for
+    QAction* trail_action = new QAction(tr("Show Trail"), this);
+    trail_action->setCheckable(true);
+    connect(trail_action, &QAction::toggled, this, [this](bool checked) {
+        setTrailLength(checked ? DEFAULT_TRAIL_LENGTH : 0);
+    });
+    
+    QAction* heatmap_action = new QAction(tr("Show Drift Heatmap"), this);
+    heatmap_action->setCheckable(true);
+    connect(heatmap_action, &QAction::toggled, this, &AxisWidget::setHeatmapEnabled);
+    
+    QAction* clear_action = new QAction(tr("Clear History"), this);
+    connect(clear_action, &QAction::triggered, this, &AxisWidget::clearHistory);
+    
+    addAction(trail_action);
+    addAction(heatmap_action);
+    addAction(clear_action);
+    setContextMenuPolicy(Qt::ActionsContextMenu);
 }
 
 void
-AxisWidget::paintEvent(QPaintEvent* event)
+AxisWidget::updateBackground()
 {
-    Q_UNUSED(event);
+    const qreal dpr = devicePixelRatioF();
+    if (!background.isNull() &&
+        background.devicePixelRatio() == dpr &&
+        background.size() == size() * dpr)
+    {
+        return;
+    }
     
-    QPainter painter(this);
+    background = QPixmap(size() * dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(Qt::transparent);
+    
+    QPainter painter(&background);
     painter.setRenderHint(QPainter::Antialiasing);
     
     int w = width() - 10;
     int h = height() - 10;
-    int px = w/2 + (w/2 * x);
-    int py = h/2 + (h/2 * y);
     
     painter.translate(5, 5);
     
@@ -71,41 +144,77 @@ AxisWidget::paintEvent(QPaintEvent* event)
     painter.drawLine(w/2, 0, w/2, h);
     painter.drawLine(0, h/2, w, h/2);
     
-    // Cursor
-    painter.setPen(QPen(Qt::black, 2.0));
-    painter.drawLine(px, py-5, px, py+5);
-    painter.drawLine(px-5, py, px+5, py);
-    
-    // Display values if enabled
+    // The value text is monospaced with fixed width fields, so its box
+    // is the same for every value
     if (show_values) {
-        std::ostringstream value_text;
-        value_text << "X: " << std::setw(6) << raw_x << " Y: " << std::setw(6) << raw_y;
-        
-        // Use system font for better scaling on HiDPI displays
-        QFont monospaceFont = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-        monospaceFont.setPointSize(10);
-        painter.setFont(monospaceFont);
-        
-        QFontMetrics fm(monospaceFont);
-        QString valueString = QString::fromStdString(value_text.str());
-        QRect textRect = fm.boundingRect(valueString);
+        QFontMetrics fm(value_font);
+        value_rect = fm.boundingRect(QString::asprintf("X: %6d Y: %6d", -32767, -32767));
         
         // Text background for better readability
         painter.setPen(Qt::NoPen);
         painter.setBrush(QBrush(QColor(255, 255, 255, 179)));
         
-        // Use QPainterPath for text background
         QPainterPath textBgPath;
-        textBgPath.addRect(w/2 - textRect.width()/2 - 2, 
-                         h - textRect.height() - 4,
-                         textRect.width() + 4,
-                         textRect.height() + 2);
+        textBgPath.addRect(w/2 - value_rect.width()/2 - 2,
+                           h - value_rect.height() - 4,
+                           value_rect.width() + 4,
+                           value_rect.height() + 2);
         painter.drawPath(textBgPath);
+    }
+}
+
+void
+AxisWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+    
+    updateBackground();
+    
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, background);
+    painter.setRenderHint(QPainter::Antialiasing);
+    
+    int w = width() - 10;
+    int h = height() - 10;
+    int px = w/2 + (w/2 * x);
+    int py = h/2 + (h/2 * y);
+    
+    painter.translate(5, 5);
+    
+    if (heatmap_enabled)
+    {
+        painter.drawImage(QRectF(0, 0, w, h), heatmap);
+    }
+    
+    // Trail, oldest segment faintest
+    if (trail_size > 1)
+    {
+        const int capacity = int(trail.size());
+        auto to_widget = [w, h](const QPoint& raw) {
+            return QPointF(w/2 + (w/2 * (raw.x() / 32767.0)), h/2 + (h/2 * (raw.y() / 32767.0)));
+        };
         
-        // Draw text - calculate position with Qt6-friendly approach
+        QPointF prev = to_widget(trail[(trail_head - trail_size + capacity) % capacity]);
+        for (int i = 1; i < trail_size; ++i)
+        {
+            QPointF next = to_widget(trail[(trail_head - trail_size + i + capacity) % capacity]);
+            painter.setPen(QPen(QColor(0, 96, 192, 32 + 192 * i / trail_size), 1.5));
+            painter.drawLine(prev, next);
+            prev = next;
+        }
+    }
+    
+    // Cursor
+    painter.setPen(QPen(Qt::black, 2.0));
+    painter.drawLine(px, py-5, px, py+5);
+    painter.drawLine(px-5, py, px+5, py);
+    
+    // Display values if enabled
+    if (show_values) {
+        painter.setFont(value_font);
         painter.setPen(Qt::black);
-        painter.drawText(QPointF(w/2 - textRect.width()/2, h - 4),
-                         valueString);
+        painter.drawText(QPointF(w/2 - value_rect.width()/2, h - 4),
+                         QString::asprintf("X: %6d Y: %6d", raw_x, raw_y));
     }
 }
 
@@ -113,6 +222,7 @@ void
 AxisWidget::setXAxis(double x_)
 {
     x = x_;
+    raw_x = x_ * 32767;
     update();
 }
 
@@ -120,6 +230,7 @@ void
 AxisWidget::setYAxis(double y_)
 {
     y = y_;
+    raw_y = y_ * 32767;
     update();
 }
 
@@ -138,3 +249,101 @@ AxisWidget::setRawY(int raw_y_value)
     y = raw_y_value / 32767.0;
     update();
 }
+
+void
+AxisWidget::setRawPosition(int raw_x_value, int raw_y_value)
+{
+    raw_x = raw_x_value;
+    raw_y = raw_y_value;
+    x = raw_x_value / 32767.0;
+    y = raw_y_value / 32767.0;
+    recordRawPosition(raw_x, raw_y);
+    update();
+}
+
+void
+AxisWidget::setTrailLength(int length)
+{
+    length = std::max(0, length);
+    if (length == int(trail.size()))
+    {
+        return;
+    }
+    
+    trail.assign(length, QPoint());
+    trail_head = 0;
+    trail_size = 0;
+    update();
+}
+
+void
+AxisWidget::setHeatmapEnabled(bool enable)
+{
+    if (enable == heatmap_enabled)
+    {
+        return;
+    }
+    
+    heatmap_enabled = enable;
+    if (heatmap_enabled)
+    {
+        heatmap_counts.assign(HEATMAP_SIZE * HEATMAP_SIZE, 0);
+        heatmap = QImage(HEATMAP_SIZE, HEATMAP_SIZE, QImage::Format_ARGB32_Premultiplied);
+        heatmap.fill(Qt::transparent);
+    }
+    else
+    {
+        heatmap_counts.clear();
+        heatmap = QImage();
+    }
+    update();
+}
+
+void
+AxisWidget::clearHistory()
+{
+    trail_head = 0;
+    trail_size = 0;
+    
+    if (heatmap_enabled)
+    {
+        std::fill(heatmap_counts.begin(), heatmap_counts.end(), 0);
+        heatmap.fill(Qt::transparent);
+    }
+    update();
+}
+
+void
+AxisWidget::recordRawPosition(int raw_x_value, int raw_y_value)
+{
+    // Both are O(1), no matter how long the history is
+    if (!trail.empty())
+    {
+        trail[trail_head] = QPoint(raw_x_value, raw_y_value);
+        trail_head = (trail_head + 1) % int(trail.size());
+        trail_size = std::min(trail_size + 1, int(trail.size()));
+    }
+    
+    if (heatmap_enabled)
+    {
+        // Uncalibrated devices can report anything, keep to the edges
+        int cx = (std::clamp(raw_x_value, -32767, 32767) + 32767) * (HEATMAP_SIZE - 1) / 65534;
+        int cy = (std::clamp(raw_y_value, -32767, 32767) + 32767) * (HEATMAP_SIZE - 1) / 65534;
+        
+        uint32_t& count = heatmap_counts[cy * HEATMAP_SIZE + cx];
+        if (count == UINT32_MAX)
+        {
+            return;
+        }
+        
+        int old_level = heatmap_level(count);
+        count += 1;
+        int new_level = heatmap_level(count);
+        
+        // Only the one pixel that changed is touched
+        if (new_level != old_level)
+        {
+            reinterpret_cast<QRgb*>(heatmap.scanLine(cy))[cx] = heatmap_ramp()[new_level];
+        }
+    }
+}
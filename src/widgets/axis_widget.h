@@ -21,12 +21,31 @@
 #define JSTEST_QT_AXIS_WIDGET_H
 
 #include <QWidget>
-#include <QFontDatabase>
+#include <QFont>
+#include <QImage>
+#include <QPixmap>
+#include <QPoint>
+#include <QRect>
+#include <vector>
+#include <stdint.h>
 
+/**
+ * Position of a two axis stick. Optionally shows a trail of the last
+ * positions and a density heatmap of every position seen since the
+ * history was cleared, which makes stick drift and dead zones visible.
+ * Both can be toggled from the context menu.
+ */
 class AxisWidget : public QWidget
 {
     Q_OBJECT
 
+public:
+    /** Trail length used when the trail is enabled from the menu */
+    static const int DEFAULT_TRAIL_LENGTH = 64;
+
+    /** Resolution of the heatmap in cells per axis */
+    static const int HEATMAP_SIZE = 128;
+
 private:
     double x;
     double y;
@@ -34,18 +53,57 @@ private:
     int raw_y;  // Raw value from -32767 to 32767
     bool show_values;  // Flag to control whether to show values or not
 
+    // Frame, circle and cross, rendered once for the current size and
+    // device pixel ratio, paintEvent() only adds cursor and values
+    QPixmap background;
+    QFont value_font;
+    QRect value_rect;
+
+    // The last positions in raw values, a fixed size ring buffer
+    std::vector<QPoint> trail;
+    int trail_head;
+    int trail_size;
+
+    // Number of events per heatmap cell and their colors, a cell is
+    // recolored when its count crosses into the next color level
+    bool heatmap_enabled;
+    std::vector<uint32_t> heatmap_counts;
+    QImage heatmap;
+
+    void updateBackground();
+
 public:
     AxisWidget(int width, int height, bool show_values = true, QWidget* parent = nullptr);
 
     void paintEvent(QPaintEvent* event) override;
 
+    /** Keep the last length positions, 0 turns the trail off */
+    void setTrailLength(int length);
+    int getTrailLength() const { return int(trail.size()); }
+
+    void setHeatmapEnabled(bool enable);
+    bool isHeatmapEnabled() const { return heatmap_enabled; }
+    const QImage& getHeatmap() const { return heatmap; }
+
+    /** Forget the trail and the heatmap */
+    void clearHistory();
+
+    /** Add one point to the trail and the heatmap without moving the
+        cursor, for a history fed at the device rate while the cursor is
+        paced. Call it once per frame, not once per axis. */
+    void recordRawPosition(int raw_x_value, int raw_y_value);
+
 public slots:
+    // These only move the cursor, the history is left alone
     void setXAxis(double x);
     void setYAxis(double y);
     
     // Methods to set raw values
     void setRawX(int raw_x_value);
     void setRawY(int raw_y_value);
+
+    /** Move the cursor and add the position to the history */
+    void setRawPosition(int raw_x_value, int raw_y_value);
 };
 
 #endif // JSTEST_QT_AXIS_WIDGET_H
@@ -0,0 +1,181 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "widgets/button_grid_widget.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QPaintEvent>
+#include <algorithm>
+
+ButtonGridWidget::ButtonGridWidget(int button_count_, int cell_width_, int cell_height_,
+                                   int rows_, int spacing_, QWidget* parent)
+    : QWidget(parent),
+      button_count(button_count_),
+      rows(rows_),
+      cell_width(cell_width_),
+      cell_height(cell_height_),
+      spacing(spacing_),
+      state(button_count_),
+      up_cells(),
+      down_cells()
+{
+    int columns = (button_count + rows - 1) / rows;
+    int visible_rows = std::min(button_count, rows);
+    setFixedSize(std::max(0, columns * (cell_width + spacing) - spacing),
+                 std::max(0, visible_rows * (cell_height + spacing) - spacing));
+    
+    // Set widget attributes for better rendering on Wayland
+    setAttribute(Qt::WA_OpaquePaintEvent, false);
+    setAttribute(Qt::WA_TranslucentBackground, false);
+    
+    // Use a proper size policy
+    setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+}
+
+bool
+ButtonGridWidget::isDown(int number) const
+{
+    return number >= 0 && number < button_count && state.testBit(number);
+}
+
+QRect
+ButtonGridWidget::cellRect(int number) const
+{
+    return QRect((number / rows) * (cell_width + spacing),
+                 (number % rows) * (cell_height + spacing),
+                 cell_width, cell_height);
+}
+
+void
+ButtonGridWidget::renderCells(QPixmap& pixmap, bool down) const
+{
+    const qreal dpr = devicePixelRatioF();
+    
+    pixmap = QPixmap(size() * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+    
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    
+    QFont font = this->font();
+    font.setPointSize(10);
+    painter.setFont(font);
+    QFontMetrics fm = painter.fontMetrics();
+    
+    int w = cell_width - 10;
+    int h = cell_height - 10;
+    
+    for (int i = 0; i < button_count; ++i)
+    {
+        QRect cell = cellRect(i);
+        
+        painter.save();
+        painter.translate(cell.x() + 5, cell.y() + 5);
+        
+        QPainterPath rectPath;
+        rectPath.addRect(0, 0, w, h);
+        painter.setPen(Qt::black);
+        painter.setBrush(down ? QBrush(Qt::black) : QBrush(Qt::NoBrush));
+        painter.drawPath(rectPath);
+        
+        // Center the text
+        QString name = QString::number(i);
+        QRect textRect = fm.boundingRect(name);
+        int textX = (w - textRect.width()) / 2;
+        int textY = (h + textRect.height()) / 2 - fm.descent();
+        
+        painter.setPen(down ? Qt::white : Qt::black);
+        painter.drawText(textX, textY, name);
+        
+        painter.restore();
+    }
+}
+
+void
+ButtonGridWidget::updateCells()
+{
+    const qreal dpr = devicePixelRatioF();
+    if (!up_cells.isNull() &&
+        up_cells.devicePixelRatio() == dpr &&
+        up_cells.size() == size() * dpr)
+    {
+        return;
+    }
+    
+    renderCells(up_cells, false);
+    renderCells(down_cells, true);
+}
+
+void
+ButtonGridWidget::paintEvent(QPaintEvent* event)
+{
+    if (button_count == 0)
+    {
+        return;
+    }
+    
+    updateCells();
+    
+    const qreal dpr = up_cells.devicePixelRatio();
+    const QRect exposed = event->rect();
+    
+    QPainter painter(this);
+    for (int i = 0; i < button_count; ++i)
+    {
+        QRect cell = cellRect(i);
+        if (!exposed.intersects(cell))
+        {
+            continue;
+        }
+        
+        // Source rectangles are in device pixels
+        painter.drawPixmap(QRectF(cell),
+                           state.testBit(i) ? down_cells : up_cells,
+                           QRectF(cell.x() * dpr, cell.y() * dpr,
+                                  cell.width() * dpr, cell.height() * dpr));
+    }
+}
+
+void
+ButtonGridWidget::changeEvent(QEvent* event)
+{
+    // The cells carry the font and colours they were rendered with
+    if (event->type() == QEvent::FontChange ||
+        event->type() == QEvent::PaletteChange)
+    {
+        up_cells = QPixmap();
+        down_cells = QPixmap();
+        update();
+    }
+    
+    QWidget::changeEvent(event);
+}
+
+void
+ButtonGridWidget::setDown(int number, bool down)
+{
+    if (number < 0 || number >= button_count || state.testBit(number) == down)
+    {
+        return;
+    }
+    
+    state.setBit(number, down);
+    update(cellRect(number));
+}
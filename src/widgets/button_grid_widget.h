@@ -0,0 +1,74 @@
+/*
+**  jstest-qt - A Qt joystick tester
+**  Copyright (C) 2025 Qt port contributors
+**
+**  This program is free software: you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JSTEST_QT_BUTTON_GRID_WIDGET_H
+#define JSTEST_QT_BUTTON_GRID_WIDGET_H
+
+#include <QWidget>
+#include <QBitArray>
+#include <QPixmap>
+#include <QRect>
+
+/**
+ * All buttons of a device in a single widget, laid out column by column
+ * like the button grid of the test dialog used to be. The cells are
+ * rendered once in their released and their pressed state, a paint only
+ * copies the cells that were invalidated, and setDown() only
+ * invalidates a cell when its state actually changed.
+ */
+class ButtonGridWidget : public QWidget
+{
+    Q_OBJECT
+
+private:
+    int button_count;
+    int rows;
+    int cell_width;
+    int cell_height;
+    int spacing;
+
+    QBitArray state;
+
+    // Every cell drawn released and drawn pressed, for the current size
+    // and device pixel ratio
+    QPixmap up_cells;
+    QPixmap down_cells;
+
+    void updateCells();
+    void renderCells(QPixmap& pixmap, bool down) const;
+
+public:
+    ButtonGridWidget(int button_count, int cell_width, int cell_height,
+                     int rows = 10, int spacing = 8, QWidget* parent = nullptr);
+
+    int getButtonCount() const { return button_count; }
+    bool isDown(int number) const;
+
+    /** Area of button number in widget coordinates */
+    QRect cellRect(int number) const;
+
+    void paintEvent(QPaintEvent* event) override;
+
+protected:
+    void changeEvent(QEvent* event) override;
+
+public slots:
+    void setDown(int number, bool down);
+};
+
+#endif // JSTEST_QT_BUTTON_GRID_WIDGET_H
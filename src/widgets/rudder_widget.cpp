@@ -24,7 +24,8 @@
 
 RudderWidget::RudderWidget(int width, int height, QWidget* parent)
     : QWidget(parent),
-      pos(0.0)
+      pos(0.0),
+      background()
 {
     setFixedSize(width, height);
     
@@ -37,14 +38,22 @@ RudderWidget::RudderWidget(int width, int height, QWidget* parent)
 }
 
 void
-RudderWidget::paintEvent(QPaintEvent* event)
+RudderWidget::updateBackground()
 {
-    Q_UNUSED(event);
+    const qreal dpr = devicePixelRatioF();
+    if (!background.isNull() &&
+        background.devicePixelRatio() == dpr &&
+        background.size() == size() * dpr)
+    {
+        return;
+    }
     
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    background = QPixmap(size() * dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(Qt::transparent);
     
-    double p = (pos + 1.0)/2.0;
+    QPainter painter(&background);
+    painter.setRenderHint(QPainter::Antialiasing);
     
     int w = width() - 10;
     int h = height() - 10;
@@ -60,6 +69,25 @@ RudderWidget::paintEvent(QPaintEvent* event)
     // Center line
     painter.setPen(QPen(QColor(0, 0, 0, 128), 0.5));
     painter.drawLine(w/2, 0, w/2, h);
+}
+
+void
+RudderWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+    
+    updateBackground();
+    
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, background);
+    painter.setRenderHint(QPainter::Antialiasing);
+    
+    double p = (pos + 1.0)/2.0;
+    
+    int w = width() - 10;
+    int h = height() - 10;
+    
+    painter.translate(5, 5);
     
     // Position indicator
     painter.setPen(QPen(Qt::black, 2.0));
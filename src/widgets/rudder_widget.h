@@ -21,6 +21,7 @@
 #define JSTEST_QT_RUDDER_WIDGET_H
 
 #include <QWidget>
+#include <QPixmap>
 
 class RudderWidget : public QWidget
 {
@@ -29,6 +30,11 @@ class RudderWidget : public QWidget
 private:
     double pos;
 
+    // Frame and center line for the current size and device pixel ratio
+    QPixmap background;
+
+    void updateBackground();
+
 public:
     RudderWidget(int width, int height, QWidget* parent = nullptr);
 
@@ -25,7 +25,8 @@
 ThrottleWidget::ThrottleWidget(int width, int height, bool invert_, QWidget* parent)
     : QWidget(parent),
       invert(invert_),
-      pos(0.0)
+      pos(0.0),
+      background()
 {
     setFixedSize(width, height);
     
@@ -38,14 +39,22 @@ ThrottleWidget::ThrottleWidget(int width, int height, bool invert_, QWidget* par
 }
 
 void
-ThrottleWidget::paintEvent(QPaintEvent* event)
+ThrottleWidget::updateBackground()
 {
-    Q_UNUSED(event);
+    const qreal dpr = devicePixelRatioF();
+    if (!background.isNull() &&
+        background.devicePixelRatio() == dpr &&
+        background.size() == size() * dpr)
+    {
+        return;
+    }
     
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    background = QPixmap(size() * dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(Qt::transparent);
     
-    double p = 1.0 - (pos + 1.0) / 2.0;
+    QPainter painter(&background);
+    painter.setRenderHint(QPainter::Antialiasing);
     
     int w = width() - 10;
     int h = height() - 10;
@@ -57,15 +66,29 @@ ThrottleWidget::paintEvent(QPaintEvent* event)
     rectPath.addRect(0, 0, w, h);
     painter.setPen(Qt::black);
     painter.drawPath(rectPath);
+}
+
+void
+ThrottleWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
     
-    // Fill rectangle based on position
-    int dh = h * p;
-    painter.setBrush(Qt::black);
-    painter.setPen(Qt::NoPen);
+    updateBackground();
+    
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, background);
     
-    QPainterPath fillPath;
-    fillPath.addRect(0, h - dh, w, dh);
-    painter.drawPath(fillPath);
+    double p = 1.0 - (pos + 1.0) / 2.0;
+    
+    int w = width() - 10;
+    int h = height() - 10;
+    
+    painter.translate(5, 5);
+    
+    // Fill rectangle based on position, axis aligned so it needs no
+    // antialiasing
+    int dh = h * p;
+    painter.fillRect(0, h - dh, w, dh, Qt::black);
 }
 
 void
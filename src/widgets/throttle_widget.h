@@ -21,6 +21,7 @@
 #define JSTEST_QT_THROTTLE_WIDGET_H
 
 #include <QWidget>
+#include <QPixmap>
 
 class ThrottleWidget : public QWidget
 {
@@ -30,6 +31,11 @@ private:
     bool invert;
     double pos;
 
+    // Frame for the current size and device pixel ratio
+    QPixmap background;
+
+    void updateBackground();
+
 public:
     ThrottleWidget(int width, int height, bool invert = false, QWidget* parent = nullptr);
 